@@ -1,4 +1,6 @@
 using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
 using Stride.Core.Mathematics;
 using Stride.Graphics;
 
@@ -14,10 +16,73 @@ namespace Alembic
         Unknown
     }
 
+    /// <summary>
+    /// Alembic::Util::PlainOldDataType
+    /// </summary>
+    public enum AttributeType
+    {
+        Boolean = 0,
+        UInt8,
+        Int8,
+        UInt16,
+        Int16,
+        UInt32,
+        Int32,
+        UInt64,
+        Int64,
+        Float16,
+        Float32,
+        Float64,
+        Unknown = 127
+    }
+
+    /// <summary>
+    /// Alembic::AbcGeom::GeometryScope
+    /// </summary>
+    public enum AttributeScope
+    {
+        Constant = 0,
+        Uniform,
+        Varying,
+        Vertex,
+        FaceVarying,
+        Unknown = 127
+    }
+
+    /// <summary>
+    /// Count elements of Extent values of Type, valid until the next update of the scene
+    /// </summary>
+    public readonly struct AttributeStream
+    {
+        public readonly IntPtr Pointer;
+        public readonly int Size, Count;
+        public readonly AttributeType Type;
+        public readonly int Extent;
+        public readonly AttributeScope Scope;
+
+        public int Stride => Count > 0 ? Size / Count : 0;
+
+        public DataPointer DataPointer => new DataPointer(Pointer, Size);
+    }
+
     internal abstract class GeomPtr
     {
         protected IntPtr self;
         public IntPtr Self => self;
+
+        public string[] AttributeNames
+        {
+            get
+            {
+                var names = new string[NativeMethods.getAttributeCount(self)];
+                for(int i = 0; i < names.Length; i++)
+                    names[i] = Marshal.PtrToStringAnsi(NativeMethods.getAttributeName(self, i));
+
+                return names;
+            }
+        }
+
+        public bool GetAttribute(string name, out AttributeStream stream) => NativeMethods.getAttribute(self, name, out stream);
     }
 
     internal class AlembicGeom : GeomPtr
@@ -43,6 +108,34 @@ namespace Alembic
 
         public int Count => NativeMethods.getPointCount(this.self);
 
+        public int SourceCount => NativeMethods.getPointSourceCount(this.self);
+
+        public float LOD { set => NativeMethods.setPointLOD(this.self, value); }
+
+        public bool SpatialIndex { set => NativeMethods.setPointSpatialIndex(this.self, value); }
+
+        public (int[], float[]) QueryRadius(Vector3 center, float radius, int maxCount)
+        {
+            var indices = new int[Math.Max(maxCount, 0)];
+            var distances = new float[indices.Length];
+            var count = NativeMethods.queryPointsRadius(this.self, center, radius, indices.Length, indices, distances);
+
+            Array.Resize(ref indices, count);
+            Array.Resize(ref distances, count);
+            return (indices, distances);
+        }
+
+        public (int[], float[]) QueryNearest(Vector3 center, int k)
+        {
+            var indices = new int[Math.Max(k, 0)];
+            var distances = new float[indices.Length];
+            var count = NativeMethods.queryPointsNearest(this.self, center, indices.Length, indices, distances);
+
+            Array.Resize(ref indices, count);
+            Array.Resize(ref distances, count);
+            return (indices, distances);
+        }
+
         public static explicit operator Points(AlembicGeom geom) => new Points(geom);
     }
 
@@ -51,9 +144,11 @@ namespace Alembic
         public Curves(IntPtr ptr) { self = ptr; }
         public Curves(AlembicGeom geom) { self = geom.Self; }
 
-        public (DataPointer, DataPointer) GetSample()
+        public (DataPointer, DataPointer) GetSample() => GetSample(out _);
+
+        public (DataPointer, DataPointer) GetSample(out bool indicesUnchanged)
         {
-            var ptr = NativeMethods.getCurveSample(this.self, out var curve, out var indices);
+            indicesUnchanged = NativeMethods.getCurveSample(this.self, out var curve, out var indices);
             if(curve.Pointer == IntPtr.Zero || curve.Size <= 0
                 || indices.Pointer == IntPtr.Zero || indices.Size <= 0)
                 throw new InvalidOperationException();
@@ -61,13 +156,49 @@ namespace Alembic
             return (curve, indices);
         }
 
+        public int Subdivision { set => NativeMethods.setCurveSubdivision(this.self, value); }
+
+        public (DataPointer, DataPointer) GetTessellatedSample(CurveTessellation mode, int sides, float widthScale, Vector3 view, out bool indicesUnchanged)
+        {
+            indicesUnchanged = NativeMethods.getCurveTessellatedSample(this.self, mode, sides, widthScale, view, out var vertices, out var indices);
+            if(vertices.Pointer == IntPtr.Zero || vertices.Size <= 0
+                || indices.Pointer == IntPtr.Zero || indices.Size <= 0)
+                throw new InvalidOperationException();
+
+            return (vertices, indices);
+        }
+
         public static explicit operator Curves(AlembicGeom geom) => new Curves(geom);
     }
 
+    public enum CurveTessellation
+    {
+        Lines = 0,
+        Ribbon,
+        Tube
+    }
+
+    /// <summary>
+    /// Attributes of a split mesh stream, in this order within the stream
+    /// </summary>
+    [Flags]
+    public enum VertexStreams
+    {
+        None = 0,
+        Position = 1,
+        Normal = 2,
+        Color = 4,
+        TextureCoordinate = 8
+    }
+
     internal enum VertexLayout
     {
         PosNormTex = 0,
         PosNormColTex,
+        PosNormTexCompact,
+        PosNormColTexCompact,
+        PosNormTanTex,
+        PosNormColTanTex,
         Unknown
     }
 
@@ -101,6 +232,26 @@ namespace Alembic
                                         VertexElement.Normal<Vector3>(),
                                         VertexElement.Color<Vector4>(),
                                         VertexElement.TextureCoordinate<Vector2>());
+                    case VertexLayout.PosNormTexCompact :
+                        return new VertexDeclaration(VertexElement.Position<Half4>(),
+                                        VertexElement.Normal(PixelFormat.R16G16_SNorm),
+                                        VertexElement.TextureCoordinate<Half2>());
+                    case VertexLayout.PosNormColTexCompact :
+                        return new VertexDeclaration(VertexElement.Position<Half4>(),
+                                        VertexElement.Normal(PixelFormat.R16G16_SNorm),
+                                        VertexElement.Color(PixelFormat.R8G8B8A8_UNorm),
+                                        VertexElement.TextureCoordinate<Half2>());
+                    case VertexLayout.PosNormTanTex :
+                        return new VertexDeclaration(VertexElement.Position<Vector3>(),
+                                        VertexElement.Normal<Vector3>(),
+                                        VertexElement.Tangent<Vector4>(),
+                                        VertexElement.TextureCoordinate<Vector2>());
+                    case VertexLayout.PosNormColTanTex :
+                        return new VertexDeclaration(VertexElement.Position<Vector3>(),
+                                        VertexElement.Normal<Vector3>(),
+                                        VertexElement.Color<Vector4>(),
+                                        VertexElement.Tangent<Vector4>(),
+                                        VertexElement.TextureCoordinate<Vector2>());
                     case VertexLayout.Unknown :
                     default :
                         throw new InvalidOperationException();
@@ -117,6 +268,59 @@ namespace Alembic
             return new DataPointer(ptr, size);
         }
 
+        public bool Compact { set => NativeMethods.setPolyMeshCompact(this.self, value); }
+
+        public bool DirtyTracking { set => NativeMethods.setPolyMeshDirtyTracking(this.self, value); }
+
+        public void SetSmoothNormals(bool smooth, float hardEdgeAngle) => NativeMethods.setPolyMeshSmoothNormals(this.self, smooth, hardEdgeAngle);
+
+        public bool Tangents { set => NativeMethods.setPolyMeshTangents(this.self, value); }
+
+        public bool SplitStreams { set => NativeMethods.setPolyMeshSplitStreams(this.self, value); }
+
+        public bool IsSplit => NativeMethods.isPolyMeshSplit(this.self);
+
+        /// <summary>
+        /// Returns true when the static stream was rewritten
+        /// </summary>
+        public bool GetSplitSample(out DataPointer dynamicPtr, out DataPointer staticPtr)
+            => NativeMethods.getPolyMeshSplitSample(this.self, out dynamicPtr, out staticPtr);
+
+        public VertexDeclaration GetStreamLayout(bool dynamic)
+        {
+            var streams = NativeMethods.getPolyMeshStreamMask(this.self, dynamic);
+            var elements = new List<VertexElement>();
+
+            if(streams.HasFlag(VertexStreams.Position)) elements.Add(VertexElement.Position<Vector3>());
+            if(streams.HasFlag(VertexStreams.Normal)) elements.Add(VertexElement.Normal<Vector3>());
+            if(streams.HasFlag(VertexStreams.Color)) elements.Add(VertexElement.Color<Vector4>());
+            if(streams.HasFlag(VertexStreams.TextureCoordinate)) elements.Add(VertexElement.TextureCoordinate<Vector2>());
+
+            return new VertexDeclaration(elements.ToArray());
+        }
+
+        public FaceSetRange[] GetFaceSets()
+        {
+            var faceSets = new FaceSetRange[NativeMethods.getPolyMeshFaceSetCount(this.self)];
+            for(int i = 0; i < faceSets.Length; i++)
+            {
+                NativeMethods.getPolyMeshFaceSetRange(this.self, i, out var first, out var count);
+                faceSets[i] = new FaceSetRange(Marshal.PtrToStringAnsi(NativeMethods.getPolyMeshFaceSetName(this.self, i)), first, count);
+            }
+
+            return faceSets;
+        }
+
+        public unsafe DataRange[] GetDirtyRanges()
+        {
+            var ptr = (DataRange*)NativeMethods.getPolyMeshDirtyRanges(this.self, out var count);
+
+            var ranges = new DataRange[count];
+            for(int i = 0; i < count; i++) ranges[i] = ptr[i];
+
+            return ranges;
+        }
+
         public BoundingBox BoundingBox => NativeMethods.getPolyMeshBoundingBox(this.self);
 
         public MeshTopologyVariance Topology => NativeMethods.getPolyMeshTopologyVariance(this.self);
@@ -124,6 +328,30 @@ namespace Alembic
         public static explicit operator PolyMesh(AlembicGeom geom) => new PolyMesh(geom);
     }
 
+    /// <summary>
+    /// Byte range of a vertex stream
+    /// </summary>
+    public readonly struct DataRange
+    {
+        public readonly int Offset, Size;
+    }
+
+    /// <summary>
+    /// Vertices of one face set in the mesh stream, draw each with its own material
+    /// </summary>
+    public readonly struct FaceSetRange
+    {
+        public readonly string Name;
+        public readonly int First, Count;
+
+        public FaceSetRange(string name, int first, int count)
+        {
+            Name = name;
+            First = first;
+            Count = count;
+        }
+    }
+
     public readonly struct CameraParam
     {
         public readonly float Aperture, Near, Far, FocalLength, FoV;
@@ -26,18 +26,37 @@ namespace Alembic
             if(scene.handle == IntPtr.Zero)
                 throw new FormatException("Failed Open : Illigal Format");
 
-            scene._nameArray = new string[scene.ObjectCount];
-            for(int i = 0; i < scene._nameArray.Length; i++)
+            scene.SetUpNames();
+            return scene;
+        }
+
+        /// <summary>
+        /// Scene with its own time over the same opened archive, e.g. one per instance of a crowd.
+        /// The file, hierarchy and mesh topologies are shared, only the playback state is per cursor
+        /// </summary>
+        public AlembicScene CreateCursor()
+        {
+            var cursor = NativeMethods.openCursor(this);
+
+            if(cursor.handle == IntPtr.Zero)
+                throw new InvalidOperationException("Failed CreateCursor : the scene is not open");
+
+            cursor.SetUpNames();
+            return cursor;
+        }
+
+        void SetUpNames()
+        {
+            _nameArray = new string[ObjectCount];
+            for(int i = 0; i < _nameArray.Length; i++)
             {
                 unsafe
                 {
-                    scene._nameArray[i] = new string(NativeMethods.getName(scene,i));
-                    scene.minTime = Math.Min(NativeMethods.getGeomMinTime(scene.GetGeom(scene._nameArray[i]).Self), scene.minTime);
-                    scene.maxTime = Math.Max(NativeMethods.getGeomMaxTime(scene.GetGeom(scene._nameArray[i]).Self), scene.maxTime);
+                    _nameArray[i] = new string(NativeMethods.getName(this,i));
+                    minTime = Math.Min(NativeMethods.getGeomMinTime(GetGeom(_nameArray[i]).Self), minTime);
+                    maxTime = Math.Max(NativeMethods.getGeomMaxTime(GetGeom(_nameArray[i]).Self), maxTime);
                 }
             }
-
-            return scene;
         }
 
         float minTime = float.PositiveInfinity;
@@ -61,8 +80,51 @@ namespace Alembic
 
         public void SetTime(float time) => NativeMethods.updateTime(this, time);
 
+        /// <summary>
+        /// Update at frame / fps, sample indices come from tables built once per fps so playback is exact on long timelines
+        /// </summary>
+        public void SetFrame(int frame, float fps = 30) => NativeMethods.updateFrame(this, frame, fps);
+
+        /// <summary>
+        /// Start decoding time on a worker thread into a second set of buffers, the current samples stay readable.
+        /// False while the previous update has not been ended
+        /// </summary>
+        public bool BeginUpdate(float time) => NativeMethods.beginUpdate(this, time);
+
+        /// <summary>
+        /// Wait for BeginUpdate and make its samples the current ones, false when none is running
+        /// </summary>
+        public bool EndUpdate() => NativeMethods.endUpdate(this);
+
+        /// <summary>
+        /// Update transforms and cameras, then Points, Curves and PolyMesh by priority and frames behind
+        /// until budget milliseconds are spent. The others keep their sample for a later frame
+        /// </summary>
+        public void SetTimeBudgeted(float time, float budget = 8) => NativeMethods.updateTimeBudgeted(this, time, budget);
+
+        /// <summary>
+        /// Weight of an object in SetTimeBudgeted, e.g. its size on screen
+        /// </summary>
+        public void SetPriority(string name, float priority) => NativeMethods.setGeomPriority(this, name, priority);
+
+        /// <summary>
+        /// Updates the object has missed and the time of the sample it shows
+        /// </summary>
+        public bool GetStaleness(string name, out int frames, out float sampleTime)
+            => NativeMethods.getGeomStaleness(this, name, out frames, out sampleTime);
+
+        /// <summary>
+        /// Time spent in the last SetTime call in milliseconds
+        /// </summary>
+        public float LastUpdateDuration => NativeMethods.getLastUpdateDuration(this);
+
         public void SetInterpolate(bool interpolate) => NativeMethods.setInterpolate(this, interpolate);
 
+        /// <summary>
+        /// Move Points and PolyMesh with velocities by P + v * dt from the previous sample, works with changing topology
+        /// </summary>
+        public void SetVelocityExtrapolate(bool extrapolate) => NativeMethods.setExtrapolate(this, extrapolate);
+
 
         AlembicGeom GetGeom(string name) => (AlembicGeom)NativeMethods.getGeom(this, name);
     }
@@ -34,6 +34,96 @@ namespace Alembic
             return false;
         }
 
+        /// <summary>
+        /// Read only a stable subset of the points, picked by a hash of their ids so the same particles stay
+        /// visible across frames. 1 reads every point, the rest are skipped before interpolation
+        /// </summary>
+        public void SetPointLOD(string name, float fraction)
+        {
+            AlembicGeom geom = GetGeom(name);
+
+            if(geom.Self != IntPtr.Zero && geom.Type == GeomType.Points)
+                ((Points)geom).LOD = fraction;
+        }
+
+        /// <summary>
+        /// LOD fraction that keeps about budget points of the current sample
+        /// </summary>
+        public void SetPointBudget(string name, int budget)
+        {
+            AlembicGeom geom = GetGeom(name);
+
+            if(geom.Self != IntPtr.Zero && geom.Type == GeomType.Points)
+            {
+                var count = ((Points)geom).SourceCount;
+                ((Points)geom).LOD = count > 0 ? Math.Min(1f, (float)budget / count) : 1f;
+            }
+        }
+
+        /// <summary>
+        /// LOD fraction falling off with the squared distance to the origin of the points, full detail up to fullDetailDistance
+        /// </summary>
+        public void SetPointLODByDistance(string name, Vector3 viewPosition, float fullDetailDistance, float minFraction = 0.01f)
+        {
+            AlembicGeom geom = GetGeom(name);
+
+            if(geom.Self != IntPtr.Zero && geom.Type == GeomType.Points)
+            {
+                var distance = Vector3.Distance(viewPosition, geom.Transform.TranslationVector);
+                var level = distance > fullDetailDistance ? fullDetailDistance / distance : 1f;
+
+                ((Points)geom).LOD = MathUtil.Clamp(level * level, minFraction, 1f);
+            }
+        }
+
+        /// <summary>
+        /// Keep a uniform grid of the points for QueryPointsRadius and QueryPointsNearest,
+        /// rebuilt on the native side only when the sample changes
+        /// </summary>
+        public void SetPointSpatialIndex(string name, bool enable)
+        {
+            AlembicGeom geom = GetGeom(name);
+
+            if(geom.Self != IntPtr.Zero && geom.Type == GeomType.Points)
+                ((Points)geom).SpatialIndex = enable;
+        }
+
+        /// <summary>
+        /// Indices and distances of the points within radius, nearest first. center is in the local space of the points
+        /// </summary>
+        public bool QueryPointsRadius(string name, Vector3 center, float radius, int maxCount, out int[] indices, out float[] distances)
+        {
+            indices = Array.Empty<int>();
+            distances = Array.Empty<float>();
+            AlembicGeom geom = GetGeom(name);
+
+            if(geom.Self != IntPtr.Zero && geom.Type == GeomType.Points)
+            {
+                (indices, distances) = ((Points)geom).QueryRadius(center, radius, maxCount);
+                return true;
+            }
+
+            return false;
+        }
+
+        /// <summary>
+        /// Indices and distances of the k nearest points, nearest first. center is in the local space of the points
+        /// </summary>
+        public bool QueryPointsNearest(string name, Vector3 center, int k, out int[] indices, out float[] distances)
+        {
+            indices = Array.Empty<int>();
+            distances = Array.Empty<float>();
+            AlembicGeom geom = GetGeom(name);
+
+            if(geom.Self != IntPtr.Zero && geom.Type == GeomType.Points)
+            {
+                (indices, distances) = ((Points)geom).QueryNearest(center, k);
+                return true;
+            }
+
+            return false;
+        }
+
         public void GetPoints(out IEnumerable<PinnedSequence<Vector3>> points, out IEnumerable<Matrix> transforms)
         {
             var pts = new List<PinnedSequence<Vector3>>();
@@ -64,16 +154,53 @@ namespace Alembic
         }
 
         public bool GetCurve(string name, out DataPointer curve, out DataPointer indices, out Matrix transform)
+            => GetCurve(name, out curve, out indices, out _, out transform);
+
+        /// <summary>
+        /// IndicesUnchanged is true when the index buffer is identical to the previous call, so only the curve points need to be uploaded
+        /// </summary>
+        public bool GetCurve(string name, out DataPointer curve, out DataPointer indices, out bool indicesUnchanged, out Matrix transform)
         {
             curve = default;
             indices = default;
+            indicesUnchanged = false;
+            transform = default;
+            AlembicGeom geom = GetGeom(name);
+
+            if(geom.Self != IntPtr.Zero && geom.Type == GeomType.Curves)
+            {
+                (curve, indices) = ((Curves)geom).GetSample(out indicesUnchanged);
+                transform = geom.Transform;
+
+                return true;
+            }
+
+            return false;
+        }
+
+        /// <summary>
+        /// Expand a curve into camera facing ribbons or tubes. ViewPosition is in world space and Ribbon faces it unless the curve has normals
+        /// </summary>
+        public bool GetCurveMesh(string name, CurveTessellation mode, int sides, float widthScale, Vector3 viewPosition,
+            out DataPointer vertices, out DataPointer indices, out VertexDeclaration layout, out bool indicesUnchanged, out Matrix transform)
+        {
+            vertices = default;
+            indices = default;
+            layout = default;
+            indicesUnchanged = false;
             transform = default;
             AlembicGeom geom = GetGeom(name);
 
             if(geom.Self != IntPtr.Zero && geom.Type == GeomType.Curves)
             {
-                (curve, indices) = ((Curves)geom).GetSample();
                 transform = geom.Transform;
+                var view = Vector3.TransformCoordinate(viewPosition, Matrix.Invert(transform));
+
+                (vertices, indices) = ((Curves)geom).GetTessellatedSample(mode, sides, widthScale, view, out indicesUnchanged);
+                layout = mode == CurveTessellation.Lines ? new VertexDeclaration(VertexElement.Position<Vector3>())
+                    : new VertexDeclaration(VertexElement.Position<Vector3>(),
+                                        VertexElement.Normal<Vector3>(),
+                                        VertexElement.TextureCoordinate<Vector2>());
 
                 return true;
             }
@@ -81,6 +208,17 @@ namespace Alembic
             return false;
         }
 
+        /// <summary>
+        /// Evaluate cubic and NURBS curves with the given number of segments per span. 0 connects the control points linearly
+        /// </summary>
+        public void SetCurveSubdivision(string name, int subdivision)
+        {
+            AlembicGeom geom = GetGeom(name);
+
+            if(geom.Self != IntPtr.Zero && geom.Type == GeomType.Curves)
+                ((Curves)geom).Subdivision = subdivision;
+        }
+
         public void GetCurves(out IEnumerable<DataPointer> curves, out IEnumerable<DataPointer> indices, out IEnumerable<Matrix> transforms)
         {
             var pts = new List<DataPointer>();
@@ -172,6 +310,119 @@ namespace Alembic
             }
         }
 
+        /// <summary>
+        /// Use half positions and uvs, octahedral normals and rgba8 colors. Normals need to be decoded with AlembicCompactNormal_ShaderFX
+        /// </summary>
+        public void SetMeshCompactLayout(string name, bool compact)
+        {
+            AlembicGeom geom = GetGeom(name);
+
+            if(geom.Self != IntPtr.Zero && geom.Type == GeomType.PolyMesh)
+                ((PolyMesh)geom).Compact = compact;
+        }
+
+        /// <summary>
+        /// Generate angle weighted smooth normals when the mesh has none, instead of flat face normals.
+        /// Edges sharper than hardEdgeAngle degrees keep split normals, 180 smooths everything
+        /// </summary>
+        public void SetMeshSmoothNormals(string name, bool smooth, float hardEdgeAngle = 180)
+        {
+            AlembicGeom geom = GetGeom(name);
+
+            if(geom.Self != IntPtr.Zero && geom.Type == GeomType.PolyMesh)
+                ((PolyMesh)geom).SetSmoothNormals(smooth, hardEdgeAngle);
+        }
+
+        /// <summary>
+        /// Add a float4 tangent (xyz, handedness) to the mesh stream for normal mapping, Layout switches to
+        /// the tangent declaration. Needs uvs, is dropped by the compact layout and keeps the mesh out of split streams
+        /// </summary>
+        public void SetMeshTangents(string name, bool tangents)
+        {
+            AlembicGeom geom = GetGeom(name);
+
+            if(geom.Self != IntPtr.Zero && geom.Type == GeomType.PolyMesh)
+                ((PolyMesh)geom).Tangents = tangents;
+        }
+
+        /// <summary>
+        /// Face set draw ranges of the last GetMesh, the stream is sorted so every face set is one contiguous range.
+        /// Faces outside any face set come last with an empty name
+        /// </summary>
+        public FaceSetRange[] GetMeshFaceSets(string name)
+        {
+            AlembicGeom geom = GetGeom(name);
+
+            if(geom.Self != IntPtr.Zero && geom.Type == GeomType.PolyMesh)
+                return ((PolyMesh)geom).GetFaceSets();
+
+            return Array.Empty<FaceSetRange>();
+        }
+
+        /// <summary>
+        /// Write constant attributes (usually uvs and colors) into a static stream only rewritten when the topology changes,
+        /// GetMeshSplit then returns the animated attributes separately while GetMesh keeps the interleaved stream.
+        /// Not used with the compact layout, tangents or changing topology
+        /// </summary>
+        public void SetMeshSplitStreams(string name, bool split)
+        {
+            AlembicGeom geom = GetGeom(name);
+
+            if(geom.Self != IntPtr.Zero && geom.Type == GeomType.PolyMesh)
+                ((PolyMesh)geom).SplitStreams = split;
+        }
+
+        /// <summary>
+        /// Animated and static streams of a mesh with SetMeshSplitStreams, upload the static one only when staticChanged
+        /// </summary>
+        public bool GetMeshSplit(string name, out DataPointer dynamicPtr, out VertexDeclaration dynamicLayout,
+            out DataPointer staticPtr, out VertexDeclaration staticLayout, out bool staticChanged, out Matrix transform)
+        {
+            dynamicPtr = staticPtr = default;
+            dynamicLayout = staticLayout = default;
+            staticChanged = false;
+            transform = default;
+            AlembicGeom geom = GetGeom(name);
+
+            if(geom.Self != IntPtr.Zero && geom.Type == GeomType.PolyMesh && ((PolyMesh)geom).IsSplit)
+            {
+                var mesh = (PolyMesh)geom;
+
+                staticChanged = mesh.GetSplitSample(out dynamicPtr, out staticPtr);
+                dynamicLayout = mesh.GetStreamLayout(true);
+                staticLayout = mesh.GetStreamLayout(false);
+                transform = geom.Transform;
+
+                return true;
+            }
+
+            return false;
+        }
+
+        /// <summary>
+        /// Track which 64KB blocks of the mesh stream changed since the previous GetMesh
+        /// </summary>
+        public void SetMeshDirtyTracking(string name, bool track)
+        {
+            AlembicGeom geom = GetGeom(name);
+
+            if(geom.Self != IntPtr.Zero && geom.Type == GeomType.PolyMesh)
+                ((PolyMesh)geom).DirtyTracking = track;
+        }
+
+        /// <summary>
+        /// Byte ranges of the mesh stream that changed in the last GetMesh
+        /// </summary>
+        public DataRange[] GetMeshDirtyRanges(string name)
+        {
+            AlembicGeom geom = GetGeom(name);
+
+            if(geom.Self != IntPtr.Zero && geom.Type == GeomType.PolyMesh)
+                return ((PolyMesh)geom).GetDirtyRanges();
+
+            return Array.Empty<DataRange>();
+        }
+
         public void GetMeshMaxProperties(string name, out int vertexCount, out float time, out BoundingBox boudingBox)
         {
             AlembicGeom geom = GetGeom(name);
@@ -197,6 +448,34 @@ namespace Alembic
                 return MeshTopologyVariance.UnKnown;
         }
 
+        /// <summary>
+        /// Names GetAttribute accepts for a Points or PolyMesh, P, .velocities, .pointIds, .widths, N, uv and arbGeomParams
+        /// </summary>
+        public string[] GetAttributeNames(string name)
+        {
+            AlembicGeom geom = GetGeom(name);
+
+            if(geom.Self != IntPtr.Zero && (geom.Type == GeomType.Points || geom.Type == GeomType.PolyMesh))
+                return geom.AttributeNames;
+
+            return Array.Empty<string>();
+        }
+
+        /// <summary>
+        /// Raw array of a named property at the current time, id, velocity and width are accepted as aliases.
+        /// Points straight into the Alembic sample when no interpolation is needed, upload it as a structured buffer
+        /// </summary>
+        public bool GetAttribute(string name, string attribute, out AttributeStream stream)
+        {
+            stream = default;
+            AlembicGeom geom = GetGeom(name);
+
+            if(geom.Self != IntPtr.Zero && (geom.Type == GeomType.Points || geom.Type == GeomType.PolyMesh))
+                return geom.GetAttribute(attribute, out stream);
+
+            return false;
+        }
+
         public bool GetCamera(string name, out Matrix view, out CameraParam proj)
         {
             view = default;
@@ -6,7 +6,12 @@ namespace Alembic.VertexAnimationTexture
 public enum BitDepth
 {
     HDR16 = PixelFormat.R16G16B16A16_Float,
-    HDR32 = PixelFormat.R32G32B32A32_Float
+    HDR32 = PixelFormat.R32G32B32A32_Float,
+
+    /// <summary>
+    /// Position and uv normalized to the baked bounds, octahedral normal
+    /// </summary>
+    Compact16 = PixelFormat.R16G16B16A16_UNorm
 }
 
 }
\ No newline at end of file
@@ -16,6 +16,9 @@ namespace Alembic
         [DllImport("VL.Alembic.Native.dll")]
         public static extern AlembicScene openScene(string path);
 
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern AlembicScene openCursor(AlembicScene source);
+
         [DllImport("VL.Alembic.Native.dll")]
         public static extern void closeScene(IntPtr ptr);
 
@@ -37,9 +40,37 @@ namespace Alembic
         [DllImport("VL.Alembic.Native.dll")]
         public static extern void updateTime(AlembicScene self, float time);
 
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern void updateFrame(AlembicScene self, int frame, float fps);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        [return: MarshalAs(UnmanagedType.U1)]
+        public static extern bool beginUpdate(AlembicScene self, float time);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        [return: MarshalAs(UnmanagedType.U1)]
+        public static extern bool endUpdate(AlembicScene self);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern void updateTimeBudgeted(AlembicScene self, float time, float budget);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        [return: MarshalAs(UnmanagedType.U1)]
+        public static extern bool setGeomPriority(AlembicScene self, string name, float priority);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        [return: MarshalAs(UnmanagedType.U1)]
+        public static extern bool getGeomStaleness(AlembicScene self, string name, out int frames, out float sampleTime);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern float getLastUpdateDuration(AlembicScene self);
+
         [DllImport("VL.Alembic.Native.dll")]
         public static extern void setInterpolate(AlembicScene self, [MarshalAs(UnmanagedType.U1)] bool interpolate);
 
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern void setExtrapolate(AlembicScene self, [MarshalAs(UnmanagedType.U1)] bool extrapolate);
+
         #endregion // AlembicScene
 
 
@@ -57,6 +88,16 @@ namespace Alembic
         [DllImport("VL.Alembic.Native.dll")]
         public static extern float getGeomMaxTime(IntPtr self);
 
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern int getAttributeCount(IntPtr self);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern IntPtr getAttributeName(IntPtr self, int index);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        [return: MarshalAs(UnmanagedType.U1)]
+        public static extern bool getAttribute(IntPtr self, string name, out AttributeStream o);
+
         #endregion // AlembicGeom
 
 
@@ -68,12 +109,36 @@ namespace Alembic
         [DllImport("VL.Alembic.Native.dll")]
         public static extern int getPointCount(IntPtr self);
 
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern int getPointSourceCount(IntPtr self);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern void setPointLOD(IntPtr self, float fraction);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern void setPointSpatialIndex(IntPtr self, [MarshalAs(UnmanagedType.U1)] bool enable);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern int queryPointsRadius(IntPtr self, Vector3 center, float radius, int maxCount, [Out] int[] indices, [Out] float[] distances);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern int queryPointsNearest(IntPtr self, Vector3 center, int k, [Out] int[] indices, [Out] float[] distances);
+
         #endregion // Points
 
         #region Curves
 
         [DllImport("VL.Alembic.Native.dll")]
-        public static extern int getCurveSample(IntPtr self, out DataPointer curve, out DataPointer indices);
+        [return: MarshalAs(UnmanagedType.U1)]
+        public static extern bool getCurveSample(IntPtr self, out DataPointer curve, out DataPointer indices);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern void setCurveSubdivision(IntPtr self, int subdivision);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        [return: MarshalAs(UnmanagedType.U1)]
+        public static extern bool getCurveTessellatedSample(IntPtr self, CurveTessellation mode, int sides, float widthScale, Vector3 view,
+            out DataPointer vertices, out DataPointer indices);
 
         #endregion // Curves
 
@@ -88,6 +153,45 @@ namespace Alembic
         [DllImport("VL.Alembic.Native.dll")]
         public static extern IntPtr getPolyMeshSample(IntPtr self, out int size);
 
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern void setPolyMeshCompact(IntPtr self, [MarshalAs(UnmanagedType.U1)] bool compact);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern void setPolyMeshDirtyTracking(IntPtr self, [MarshalAs(UnmanagedType.U1)] bool track);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern void setPolyMeshSmoothNormals(IntPtr self, [MarshalAs(UnmanagedType.U1)] bool smooth, float hardEdgeAngle);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern void setPolyMeshTangents(IntPtr self, [MarshalAs(UnmanagedType.U1)] bool tangents);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern void setPolyMeshSplitStreams(IntPtr self, [MarshalAs(UnmanagedType.U1)] bool split);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        [return: MarshalAs(UnmanagedType.U1)]
+        public static extern bool isPolyMeshSplit(IntPtr self);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern VertexStreams getPolyMeshStreamMask(IntPtr self, [MarshalAs(UnmanagedType.U1)] bool dynamic);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        [return: MarshalAs(UnmanagedType.U1)]
+        public static extern bool getPolyMeshSplitSample(IntPtr self, out DataPointer dynamicPtr, out DataPointer staticPtr);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern int getPolyMeshFaceSetCount(IntPtr self);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern IntPtr getPolyMeshFaceSetName(IntPtr self, int index);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        [return: MarshalAs(UnmanagedType.U1)]
+        public static extern bool getPolyMeshFaceSetRange(IntPtr self, int index, out int first, out int count);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern IntPtr getPolyMeshDirtyRanges(IntPtr self, out int count);
+
         [DllImport("VL.Alembic.Native.dll")]
         public static extern BoundingBox getPolyMeshBoundingBox(IntPtr self);
 
@@ -108,5 +212,30 @@ namespace Alembic
         public static extern void getCameraSample(IntPtr self, out Matrix v, out CameraParam p);
 
         #endregion // Camera
+
+
+        #region VertexAnimationTexture
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern VertexAnimationTexture.VertexAnimationBake bakeVertexAnimation(AlembicScene scene, string name,
+            float startTime, float endTime, int fps, int textureWidth, [MarshalAs(UnmanagedType.U1)] bool interpolate, int encoding,
+            [MarshalAs(UnmanagedType.U1)] bool rigid, float tolerance);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern VertexAnimationTexture.VertexAnimationInfo getVATInfo(VertexAnimationTexture.VertexAnimationBake self);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern void getVATTextures(VertexAnimationTexture.VertexAnimationBake self, out DataPointer position, out DataPointer normal);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern IntPtr getVATFrameRemap(VertexAnimationTexture.VertexAnimationBake self, out int count);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern void getVATRestData(VertexAnimationTexture.VertexAnimationBake self, out DataPointer position, out DataPointer normal);
+
+        [DllImport("VL.Alembic.Native.dll")]
+        public static extern void closeVAT(IntPtr ptr);
+
+        #endregion // VertexAnimationTexture
     }
 }
\ No newline at end of file
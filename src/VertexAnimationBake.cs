@@ -0,0 +1,231 @@
+using System;
+using System.Globalization;
+using System.IO;
+using System.Linq;
+using Microsoft.Win32.SafeHandles;
+using Stride.Core;
+using Stride.Core.Mathematics;
+using Stride.Graphics;
+
+namespace Alembic.VertexAnimationTexture
+{
+    /// <summary>
+    /// Metadata VertexAnimationTexturePlayer needs to read a baked texture
+    /// </summary>
+    public readonly struct VertexAnimationInfo
+    {
+        public readonly int Fps, FrameCount;
+        public readonly float EndTime;
+        public readonly int TextureWidth, TextureHeight;
+        public readonly int NumLines, VertexCount;
+
+        internal readonly int Encoding;
+
+        /// <summary>
+        /// Decode range of Compact16
+        /// </summary>
+        public readonly Vector3 BoundsMin, BoundsMax;
+        public readonly Vector2 UvMin, UvMax;
+
+        /// <summary>
+        /// Number of rigid pieces, 0 for per vertex bakes
+        /// </summary>
+        public readonly int PieceCount;
+
+        /// <summary>
+        /// Frames stored per line, less than FrameCount when the bake is reduced
+        /// </summary>
+        public readonly int KeyFrameCount;
+    }
+
+    /// <summary>
+    /// Vertex animation texture baked on the cpu, no GraphicsDevice required
+    /// </summary>
+    public sealed class VertexAnimationBake : SafeHandleZeroOrMinusOneIsInvalid
+    {
+        public VertexAnimationBake() : base(true) {}
+
+        protected override bool ReleaseHandle()
+        {
+            NativeMethods.closeVAT(handle);
+            return true;
+        }
+
+        /// <summary>
+        /// Evaluate every frame of the PolyMesh in parallel, name is the full name of the object.
+        /// Rigid bakes one translation and rotation per connected piece instead of every vertex.
+        /// A tolerance above 0 drops frames that linear interpolation reproduces within that distance
+        /// </summary>
+        public static VertexAnimationBake Bake(AlembicScene scene, string name, float startTime, float endTime,
+            int fps = 30, int textureWidth = 0, bool interpolate = true, BitDepth depth = BitDepth.HDR32, bool rigid = false,
+            float tolerance = 0)
+        {
+            var bake = NativeMethods.bakeVertexAnimation(scene, name, startTime, endTime, fps, textureWidth, interpolate, ToEncoding(depth), rigid, tolerance);
+
+            if(bake.IsInvalid)
+                throw new ArgumentException($"Failed Bake : {name} is not a PolyMesh, the range is empty " +
+                    "or rigid is used with Compact16 / changing topology");
+
+            bake.Info = NativeMethods.getVATInfo(bake);
+            bake.Depth = depth;
+            return bake;
+        }
+
+        // matches VATEncoding on the native side and Encoding of VATPlayer
+        static int ToEncoding(BitDepth depth)
+        {
+            switch(depth)
+            {
+                case BitDepth.Compact16: return 1;
+                case BitDepth.HDR16: return 2;
+                default: return 0;
+            }
+        }
+
+        public VertexAnimationInfo Info { get; private set; }
+
+        public BitDepth Depth { get; private set; }
+
+        /// <summary>
+        /// Encoding value for VATPlayer, 1 when the textures are Compact16
+        /// </summary>
+        public int Encoding => Depth == BitDepth.Compact16 ? 1 : 0;
+
+        public Int2 TextureSize => new Int2(Info.TextureWidth, Info.TextureHeight);
+
+        public bool IsRigid => Info.PieceCount > 0;
+
+        public bool IsReduced => Info.KeyFrameCount < Info.FrameCount;
+
+        /// <summary>
+        /// FrameSize of VATPlayer, one over the frames stored per line
+        /// </summary>
+        public float FrameSize => 1f / Info.KeyFrameCount;
+
+        public Vector3 BoundsSize => Info.BoundsMax - Info.BoundsMin;
+
+        public Vector2 UvSize => Info.UvMax - Info.UvMin;
+
+        /// <summary>
+        /// (position, u) and (normal, v) texels, (octahedral normal, v, 0) for Compact16
+        /// </summary>
+        public (DataPointer, DataPointer) GetData()
+        {
+            NativeMethods.getVATTextures(this, out var position, out var normal);
+            return (position, normal);
+        }
+
+        /// <summary>
+        /// Fractional key frame of every baked frame, empty when the bake is not reduced
+        /// </summary>
+        public unsafe float[] GetFrameRemap()
+        {
+            var ptr = (float*)NativeMethods.getVATFrameRemap(this, out var count);
+
+            var remap = new float[count];
+            for(int i = 0; i < count; i++) remap[i] = ptr[i];
+
+            return remap;
+        }
+
+        /// <summary>
+        /// FrameRemap buffer of VATPlayer
+        /// </summary>
+        public Stride.Graphics.Buffer CreateFrameRemapBuffer(GraphicsDevice device)
+        {
+            var remap = IsReduced ? GetFrameRemap() : new[] { 0f };
+            return Stride.Graphics.Buffer.Typed.New(device, remap, PixelFormat.R32_Float);
+        }
+
+        /// <summary>
+        /// (position, piece id) and (normal, 0) of every vertex at the first frame, for rigid bakes
+        /// </summary>
+        public (DataPointer, DataPointer) GetRestData()
+        {
+            NativeMethods.getVATRestData(this, out var position, out var normal);
+            return (position, normal);
+        }
+
+        /// <summary>
+        /// RestPositions and RestNormals structured buffers of VATPlayer
+        /// </summary>
+        public (Stride.Graphics.Buffer, Stride.Graphics.Buffer) CreateRestBuffers(GraphicsDevice device)
+        {
+            var (position, normal) = GetRestData();
+            var flags = BufferFlags.StructuredBuffer | BufferFlags.ShaderResource;
+
+            return (Stride.Graphics.Buffer.New(device, position, Utilities.SizeOf<Vector4>(), flags),
+                    Stride.Graphics.Buffer.New(device, normal, Utilities.SizeOf<Vector4>(), flags));
+        }
+
+        public (Texture, Texture) CreateTextures(GraphicsDevice device)
+        {
+            var (position, normal) = GetData();
+            var format = (PixelFormat)Depth;
+            var rowPitch = Info.TextureWidth * format.SizeInBytes();
+
+            var positionTexture = Texture.New2D(device, Info.TextureWidth, Info.TextureHeight, 1, format,
+                new[] { new DataBox(position.Pointer, rowPitch, position.Size) });
+            var normalTexture = Texture.New2D(device, Info.TextureWidth, Info.TextureHeight, 1, format,
+                new[] { new DataBox(normal.Pointer, rowPitch, normal.Size) });
+
+            return (positionTexture, normalTexture);
+        }
+
+        /// <summary>
+        /// Write Attributes.json in the same format as VertexAnimationTextureWriter
+        /// </summary>
+        public void WriteAttributes(string path)
+        {
+            var fps = Info.Fps.ToString(CultureInfo.InvariantCulture);
+            var frameCount = Info.FrameCount.ToString(CultureInfo.InvariantCulture);
+            var endTime = Info.EndTime.ToString("R", CultureInfo.InvariantCulture);
+
+            var extra = string.Empty;
+            if(Depth == BitDepth.Compact16)
+            {
+                extra =
+                    $",\n    \"Encoding\": \"{Encoding}\",\n" +
+                    $"    \"BoundsMin\": \"{Format(Info.BoundsMin)}\",\n" +
+                    $"    \"BoundsMax\": \"{Format(Info.BoundsMax)}\",\n" +
+                    $"    \"UvMin\": \"{Format(Info.UvMin)}\",\n" +
+                    $"    \"UvMax\": \"{Format(Info.UvMax)}\"";
+            }
+
+            if(IsRigid)
+            {
+                extra +=
+                    ",\n    \"Rigid\": \"1\",\n" +
+                    $"    \"PieceCount\": \"{Info.PieceCount.ToString(CultureInfo.InvariantCulture)}\"";
+            }
+
+            if(IsReduced)
+            {
+                var remap = GetFrameRemap().Select(x => x.ToString("R", CultureInfo.InvariantCulture));
+                extra +=
+                    $",\n    \"KeyFrameCount\": \"{Info.KeyFrameCount.ToString(CultureInfo.InvariantCulture)}\",\n" +
+                    $"    \"FrameRemap\": \"{string.Join(", ", remap)}\"";
+            }
+
+            File.WriteAllText(path,
+                "{\n" +
+                "  \"?xml\": {\n" +
+                "    \"@version\": \"1.0\",\n" +
+                "    \"@encoding\": \"UTF-8\",\n" +
+                "    \"@standalone\": \"yes\"\n" +
+                "  },\n" +
+                "  \"!DOCTYPE\": {\n" +
+                "    \"@name\": \"ROOT\"\n" +
+                "  },\n" +
+                "  \"VATAttributes\": {\n" +
+                $"    \"Fps\": \"{fps}\",\n" +
+                $"    \"FrameCount\": \"{frameCount}\",\n" +
+                $"    \"EndTime\": \"{endTime}\"" + extra + "\n" +
+                "  }\n" +
+                "}");
+        }
+
+        static string Format(Vector3 v) => string.Join(", ", new[] { v.X, v.Y, v.Z }.Select(x => x.ToString("R", CultureInfo.InvariantCulture)));
+        static string Format(Vector2 v) => string.Join(", ", new[] { v.X, v.Y }.Select(x => x.ToString("R", CultureInfo.InvariantCulture)));
+    }
+}
@@ -0,0 +1,531 @@
+// performance regression suite over the exported C API of VL.Alembic.Native.
+//
+// writes fixed synthetic archives, plays them through openScene / updateTime and the sample getters,
+// and compares the median time of every workload against baselines\<machine>.txt and the checksum
+// of everything the getters returned against baselines\checksums.txt.
+//
+//   VL.Alembic.Bench.exe [--update] [--tolerance 0.15] [--repeat 7] [--dir <baseline directory>]
+//
+// --update writes the current timings and checksums as the new baselines. the exit code is 1 when a
+// workload is slower than its baseline by more than the tolerance, its output changed or it has no
+// checksum baseline. timings are per machine, a missing one is only reported.
+
+#include <Alembic\AbcGeom\All.h>
+#include <Alembic\AbcCoreOgawa\All.h>
+
+#include "AlembicReader.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+
+using namespace Alembic::AbcGeom;
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    const double Fps = 30;
+    const int FrameCount = 48;
+
+    // FNV-1a over every byte the C API returned, the same on every machine
+    struct Checksum
+    {
+        uint64_t value = 14695981039346656037ull;
+
+        void add(const void* data, size_t size)
+        {
+            const uint8_t* bytes = (const uint8_t*)data;
+            for (size_t i = 0; i < size; ++i)
+            {
+                value ^= bytes[i];
+                value *= 1099511628211ull;
+            }
+        }
+    };
+
+    // how a workload moves the scene through time
+    enum class Drive
+    {
+        Time,       // updateTime
+        Frame,      // updateFrame, one archive frame per step
+        Async,      // beginUpdate of the next time while the current one is read, then endUpdate
+    };
+
+    struct Workload
+    {
+        string name;
+        string file;
+        bool interpolate;
+
+        // time step through the archive, off the sample times when interpolating
+        float step;
+
+        function<void(abcrScene*, Checksum&)> read;
+
+        // object settings applied once after open
+        function<void(abcrScene*)> setUp = nullptr;
+
+        Drive drive = Drive::Time;
+    };
+
+    struct Result
+    {
+        double milliseconds = 0;
+        uint64_t checksum = 0;
+    };
+
+    float wave(float x, float z, int frame)
+    {
+        return 0.25f * sinf(x * 3 + frame * 0.2f) * cosf(z * 2 - frame * 0.1f);
+    }
+
+    void writeGrid(const string& path, int resolution)
+    {
+        OArchive archive(Alembic::AbcCoreOgawa::WriteArchive(), path);
+        const uint32_t ts = archive.addTimeSampling(TimeSampling(1 / Fps, 0));
+
+        OPolyMesh mesh(OObject(archive, kTop), "grid", ts);
+        OPolyMeshSchema& schema = mesh.getSchema();
+
+        const int n = resolution + 1;
+        vector<int32_t> indices, counts;
+        vector<V2f> uvs;
+        for (int z = 0; z < resolution; ++z)
+        {
+            for (int x = 0; x < resolution; ++x)
+            {
+                const int i = z * n + x;
+                const int quad[4] = { i, i + n, i + n + 1, i + 1 };
+                for (int k = 0; k < 4; ++k)
+                {
+                    indices.push_back(quad[k]);
+                    uvs.push_back(V2f((float)(quad[k] % n) / resolution, (float)(quad[k] / n) / resolution));
+                }
+                counts.push_back(4);
+            }
+        }
+
+        vector<V3f> points(n * n);
+        for (int frame = 0; frame < FrameCount; ++frame)
+        {
+            for (int z = 0; z < n; ++z)
+            {
+                for (int x = 0; x < n; ++x)
+                {
+                    const float fx = (float)x / resolution;
+                    const float fz = (float)z / resolution;
+                    points[z * n + x] = V3f(fx, wave(fx, fz, frame), fz);
+                }
+            }
+
+            OPolyMeshSchema::Sample sample(V3fArraySample(points), Int32ArraySample(indices), Int32ArraySample(counts),
+                OV2fGeomParam::Sample(V2fArraySample(uvs), kFacevaryingScope));
+            schema.set(sample);
+        }
+    }
+
+    void writePoints(const string& path, int count)
+    {
+        OArchive archive(Alembic::AbcCoreOgawa::WriteArchive(), path);
+        const uint32_t ts = archive.addTimeSampling(TimeSampling(1 / Fps, 0));
+
+        OPoints points(OObject(archive, kTop), "points", ts);
+        OPointsSchema& schema = points.getSchema();
+
+        vector<V3f> positions(count);
+        vector<uint64_t> ids(count);
+        for (int i = 0; i < count; ++i) ids[i] = (uint64_t)i;
+
+        for (int frame = 0; frame < FrameCount; ++frame)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                const float a = i * 0.001f + frame * 0.05f;
+                positions[i] = V3f(cosf(a) * (1 + i % 7), (float)(i % 101) * 0.01f + frame * 0.01f, sinf(a) * (1 + i % 5));
+            }
+
+            schema.set(OPointsSchema::Sample(V3fArraySample(positions), UInt64ArraySample(ids)));
+        }
+    }
+
+    void writeCurves(const string& path, int count, int vertices)
+    {
+        OArchive archive(Alembic::AbcCoreOgawa::WriteArchive(), path);
+        const uint32_t ts = archive.addTimeSampling(TimeSampling(1 / Fps, 0));
+
+        OCurves curves(OObject(archive, kTop), "curves", ts);
+        OCurvesSchema& schema = curves.getSchema();
+
+        vector<V3f> positions(count * vertices);
+        vector<int32_t> numVertices(count, vertices);
+
+        for (int frame = 0; frame < FrameCount; ++frame)
+        {
+            for (int c = 0; c < count; ++c)
+            {
+                const float x = (float)(c % 64) / 64;
+                const float z = (float)(c / 64) / 64;
+                for (int v = 0; v < vertices; ++v)
+                {
+                    const float h = (float)v / (vertices - 1);
+                    positions[c * vertices + v] = V3f(x + wave(x, h, frame) * h, h, z);
+                }
+            }
+
+            schema.set(OCurvesSchema::Sample(V3fArraySample(positions), Int32ArraySample(numVertices), kCubic, kNonPeriodic));
+        }
+    }
+
+    // separate quads lifted one after another, split over two face sets that alternate faces so the
+    // stream order the face sets give differs from the face order
+    void writeShatter(const string& path, int pieces)
+    {
+        OArchive archive(Alembic::AbcCoreOgawa::WriteArchive(), path);
+        const uint32_t ts = archive.addTimeSampling(TimeSampling(1 / Fps, 0));
+
+        OPolyMesh mesh(OObject(archive, kTop), "shatter", ts);
+        OPolyMeshSchema& schema = mesh.getSchema();
+
+        vector<int32_t> indices, counts, even, odd;
+        for (int p = 0; p < pieces; ++p)
+        {
+            for (int k = 0; k < 4; ++k) indices.push_back(p * 4 + k);
+            counts.push_back(4);
+            (p % 2 == 0 ? even : odd).push_back(p);
+        }
+
+        vector<V3f> points(pieces * 4);
+        for (int frame = 0; frame < FrameCount; ++frame)
+        {
+            for (int p = 0; p < pieces; ++p)
+            {
+                // piece p stays inside x in [2p, 2p + 1]
+                const float x = p * 2.0f;
+                const float y = std::max(0, frame - p) * 0.05f;
+                points[p * 4 + 0] = V3f(x, y, 0);
+                points[p * 4 + 1] = V3f(x, y, 1);
+                points[p * 4 + 2] = V3f(x + 1, y, 1);
+                points[p * 4 + 3] = V3f(x + 1, y, 0);
+            }
+
+            schema.set(OPolyMeshSchema::Sample(V3fArraySample(points), Int32ArraySample(indices), Int32ArraySample(counts)));
+        }
+
+        OFaceSet evenSet = schema.createFaceSet("even");
+        evenSet.getSchema().set(OFaceSetSchema::Sample(Int32ArraySample(even)));
+
+        OFaceSet oddSet = schema.createFaceSet("odd");
+        oddSet.getSchema().set(OFaceSetSchema::Sample(Int32ArraySample(odd)));
+    }
+
+    PolyMesh* grid(abcrScene* scene) { return (PolyMesh*)getGeom(scene, "/grid"); }
+    Points* points(abcrScene* scene) { return (Points*)getGeom(scene, "/points"); }
+    Curves* curves(abcrScene* scene) { return (Curves*)getGeom(scene, "/curves"); }
+
+    void readMesh(abcrScene* scene, Checksum& sum)
+    {
+        int size = 0;
+        const float* stream = getPolyMeshSample(grid(scene), &size);
+        if (stream) sum.add(stream, size);
+    }
+
+    void readMeshSplit(abcrScene* scene, Checksum& sum)
+    {
+        if (!isPolyMeshSplit(grid(scene))) throw runtime_error("mesh is not split");
+
+        DataPointer dynamicStream(nullptr, 0), staticStream(nullptr, 0);
+        getPolyMeshSplitSample(grid(scene), &dynamicStream, &staticStream);
+
+        if (dynamicStream.Pointer) sum.add(dynamicStream.Pointer, dynamicStream.Size);
+        if (staticStream.Pointer) sum.add(staticStream.Pointer, staticStream.Size);
+    }
+
+    void readPoints(abcrScene* scene, Checksum& sum)
+    {
+        static vector<float> buffer;
+
+        Points* p = points(scene);
+        buffer.resize((size_t)getPointCount(p) * 3);
+        getPointSample(p, buffer.data());
+        sum.add(buffer.data(), buffer.size() * sizeof(float));
+    }
+
+    // switch the LOD between updates, the count has to follow right away
+    void readPointsLODSwitch(abcrScene* scene, Checksum& sum)
+    {
+        Points* p = points(scene);
+        const int source = getPointSourceCount(p);
+
+        setPointLOD(p, 1);
+        if (getPointCount(p) != source) throw runtime_error("point count not updated by setLOD(1)");
+        readPoints(scene, sum);
+
+        setPointLOD(p, 0.25f);
+        if (getPointCount(p) < source / 8 || getPointCount(p) > source / 2) throw runtime_error("point count not updated by setLOD(0.25)");
+        readPoints(scene, sum);
+    }
+
+    void readCurves(abcrScene* scene, Checksum& sum)
+    {
+        DataPointer curve(nullptr, 0), index(nullptr, 0);
+        getCurveSample(curves(scene), &curve, &index);
+
+        if (curve.Pointer) sum.add(curve.Pointer, curve.Size);
+        if (index.Pointer) sum.add(index.Pointer, index.Size);
+    }
+
+    void readCurvesTube(abcrScene* scene, Checksum& sum)
+    {
+        DataPointer geom(nullptr, 0), index(nullptr, 0);
+        getCurveTessellatedSample(curves(scene), CurveTessellation::TUBE, 6, 1, Vector3(0, 0, 1), &geom, &index);
+
+        if (geom.Pointer) sum.add(geom.Pointer, geom.Size);
+        if (index.Pointer) sum.add(index.Pointer, index.Size);
+    }
+
+    // rigid bake of the shatter mesh once per update, every piece id has to cover the vertices of one quad
+    void readRigidVAT(abcrScene* scene, Checksum& sum)
+    {
+        VATBaker* baker = bakeVertexAnimation(scene, "/shatter", getMinTime(scene), getMaxTime(scene), (int)Fps, 256,
+            false, VATEncoding::FLOAT32, true, 0);
+        if (!baker) throw runtime_error("rigid bake failed");
+
+        DataPointer rest(nullptr, 0), normal(nullptr, 0);
+        getVATRestData(baker, &rest, &normal);
+
+        const float* v = (const float*)rest.Pointer;
+        const int count = getVATInfo(baker).VertexCount;
+        map<int, int> quadOfPiece;
+
+        for (int i = 0; i < count; ++i)
+        {
+            const int piece = (int)v[i * 4 + 3];
+            const int quad = (int)floorf(v[i * 4] / 2 + 0.25f);
+            if (v[(i - i % 3) * 4 + 3] != v[i * 4 + 3] || quadOfPiece.emplace(piece, quad).first->second != quad)
+            {
+                closeVAT(baker);
+                throw runtime_error("vertex " + to_string(i) + " is in the wrong piece");
+            }
+        }
+
+        sum.add(rest.Pointer, rest.Size);
+        closeVAT(baker);
+    }
+
+    Result run(const Workload& w, const fs::path& dir, int repeat)
+    {
+        Result result;
+        vector<double> times;
+
+        for (int r = 0; r < repeat; ++r)
+        {
+            abcrScene* scene = openScene((dir / w.file).string().c_str());
+            if (!scene) throw runtime_error("cannot open " + w.file);
+
+            setInterpolate(scene, w.interpolate);
+            if (w.setUp) w.setUp(scene);
+
+            vector<float> steps;
+            if (w.drive == Drive::Frame)
+            {
+                for (int frame = 0; frame < FrameCount; ++frame) steps.push_back((float)(frame / Fps));
+            }
+            else
+            {
+                const float end = getMaxTime(scene);
+                for (float time = getMinTime(scene); time <= end; time += w.step) steps.push_back(time);
+            }
+
+            Checksum sum;
+            auto begin = chrono::steady_clock::now();
+
+            if (w.drive == Drive::Async && !steps.empty()) beginUpdate(scene, steps[0]);
+
+            for (size_t i = 0; i < steps.size(); ++i)
+            {
+                if (w.drive == Drive::Time) updateTime(scene, steps[i]);
+                else if (w.drive == Drive::Frame) updateFrame(scene, (int)i, (float)Fps);
+                else
+                {
+                    // the next update decodes while this one is read
+                    endUpdate(scene);
+                    if (i + 1 < steps.size()) beginUpdate(scene, steps[i + 1]);
+                }
+
+                w.read(scene, sum);
+            }
+
+            times.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count());
+            closeScene(scene);
+
+            // every repetition has to produce the same output
+            if (r > 0 && sum.value != result.checksum) throw runtime_error(w.name + " is not deterministic");
+            result.checksum = sum.value;
+        }
+
+        sort(times.begin(), times.end());
+        result.milliseconds = times[times.size() / 2];
+        return result;
+    }
+
+    // "name milliseconds" per line
+    map<string, double> readTimings(const string& path)
+    {
+        map<string, double> entries;
+
+        ifstream file(path);
+        string line;
+        while (getline(file, line))
+        {
+            istringstream s(line);
+            string name;
+            double ms = 0;
+            if (line.empty() || line[0] == '#') continue;
+            if (s >> name >> ms) entries[name] = ms;
+        }
+
+        return entries;
+    }
+
+    // "name checksum" per line, the checksum in hex
+    map<string, uint64_t> readChecksums(const string& path)
+    {
+        map<string, uint64_t> entries;
+
+        ifstream file(path);
+        string line;
+        while (getline(file, line))
+        {
+            istringstream s(line);
+            string name;
+            uint64_t checksum = 0;
+            if (line.empty() || line[0] == '#') continue;
+            if (s >> name >> hex >> checksum) entries[name] = checksum;
+        }
+
+        return entries;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool update = false;
+    double tolerance = 0.15;
+    int repeat = 7;
+    fs::path dir = "baselines";
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const string arg = argv[i];
+        if (arg == "--update") update = true;
+        else if (arg == "--tolerance" && i + 1 < argc) tolerance = atof(argv[++i]);
+        else if (arg == "--repeat" && i + 1 < argc) repeat = std::max(1, atoi(argv[++i]));
+        else if (arg == "--dir" && i + 1 < argc) dir = argv[++i];
+    }
+
+    const char* machineName = getenv("COMPUTERNAME");
+    const string machine = machineName ? machineName : "default";
+
+    const fs::path workDir = dir / "work";
+
+    error_code error;
+    fs::create_directories(workDir, error);
+    if (error)
+    {
+        cout << "cannot create " << workDir.string() << " : " << error.message() << endl;
+        return 1;
+    }
+
+    writeGrid((workDir / "grid.abc").string(), 256);
+    writePoints((workDir / "points.abc").string(), 200000);
+    writeCurves((workDir / "curves.abc").string(), 4096, 16);
+    writeShatter((workDir / "shatter.abc").string(), 64);
+
+    const float frame = (float)(1 / Fps);
+    const vector<Workload> workloads =
+    {
+        { "polymesh", "grid.abc", false, frame, readMesh },
+        { "polymesh_interpolate", "grid.abc", true, frame * 0.5f, readMesh },
+        { "points", "points.abc", false, frame, readPoints },
+        { "points_interpolate", "points.abc", true, frame * 0.5f, readPoints },
+        { "curves", "curves.abc", false, frame, readCurves },
+
+        { "polymesh_frame", "grid.abc", false, frame, readMesh, nullptr, Drive::Frame },
+        { "polymesh_async", "grid.abc", false, frame, readMesh, nullptr, Drive::Async },
+        { "polymesh_compact", "grid.abc", false, frame, readMesh, [](abcrScene* s) { setPolyMeshCompact(grid(s), true); } },
+        { "polymesh_tangents", "grid.abc", false, frame, readMesh, [](abcrScene* s) { setPolyMeshTangents(grid(s), true); } },
+        { "polymesh_split", "grid.abc", false, frame, readMeshSplit, [](abcrScene* s) { setPolyMeshSplitStreams(grid(s), true); } },
+        { "polymesh_smooth_normals", "grid.abc", false, frame, readMesh, [](abcrScene* s) { setPolyMeshSmoothNormals(grid(s), true, 60); } },
+        { "points_lod", "points.abc", false, frame, readPoints, [](abcrScene* s) { setPointLOD(points(s), 0.25f); } },
+        { "points_lod_switch", "points.abc", false, frame, readPointsLODSwitch },
+        { "curves_subdivision", "curves.abc", false, frame, readCurves, [](abcrScene* s) { setCurveSubdivision(curves(s), 4); } },
+        { "curves_tube", "curves.abc", false, frame, readCurvesTube },
+        { "vat_rigid_facesets", "shatter.abc", false, (float)(FrameCount / Fps), readRigidVAT },
+    };
+
+    const string timingPath = (dir / (machine + ".txt")).string();
+    const string checksumPath = (dir / "checksums.txt").string();
+
+    auto timings = readTimings(timingPath);
+    auto checksums = readChecksums(checksumPath);
+
+    ofstream newTimings, newChecksums;
+    if (update)
+    {
+        newTimings.open(timingPath);
+        newChecksums.open(checksumPath);
+
+        newChecksums << "# workload checksum, output of VL.Alembic.Bench.exe --update, the same on every machine\n";
+    }
+
+    int failures = 0;
+    for (const auto& w : workloads)
+    {
+        Result r;
+        try
+        {
+            r = run(w, workDir, repeat);
+        }
+        catch (const exception& e)
+        {
+            cout << "FAIL " << w.name << " : " << e.what() << endl;
+            ++failures;
+            continue;
+        }
+
+        string status = "new";
+        if (!update)
+        {
+            auto t = timings.find(w.name);
+            auto c = checksums.find(w.name);
+
+            // the output is the same on every machine, so a missing checksum is a broken baseline
+            status = "ok";
+            if (c == checksums.end()) status = "FAIL no checksum baseline, run --update and commit checksums.txt";
+            else if (c->second != r.checksum) status = "FAIL output changed";
+            else if (t != timings.end() && r.milliseconds > t->second * (1 + tolerance)) status = "FAIL slower";
+            else if (t == timings.end()) status = "ok, no timing baseline for " + machine;
+
+            if (status.compare(0, 4, "FAIL") == 0) ++failures;
+
+            if (t != timings.end())
+                cout << w.name << " " << r.milliseconds << " ms (baseline " << t->second << " ms) " << status << endl;
+            else
+                cout << w.name << " " << r.milliseconds << " ms " << status << endl;
+        }
+        else
+        {
+            newTimings << w.name << " " << r.milliseconds << "\n";
+            newChecksums << w.name << " " << hex << r.checksum << dec << "\n";
+            cout << w.name << " " << r.milliseconds << " ms written" << endl;
+        }
+    }
+
+    return failures > 0 ? 1 : 0;
+}
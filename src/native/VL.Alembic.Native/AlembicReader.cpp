@@ -6,6 +6,17 @@ abcrAPI abcrScene* openScene(const char* path)
 	return scene->open(path) ? scene : nullptr;
 }
 
+abcrAPI abcrScene* openCursor(abcrScene* source)
+{
+	if (!source) return nullptr;
+
+	auto* scene = new abcrScene();
+	if (scene->openCursor(*source)) return scene;
+
+	delete scene;
+	return nullptr;
+}
+
 abcrAPI void closeScene(abcrScene* scene)
 {
 	if(scene) delete scene;
@@ -41,11 +52,53 @@ abcrAPI void updateTime(abcrScene* scene, float time)
 	if (scene) scene->updateSample(time);
 }
 
+abcrAPI void updateFrame(abcrScene* scene, int frame, float fps)
+{
+	if (scene) scene->updateFrame(frame, fps);
+}
+
+abcrAPI bool beginUpdate(abcrScene* scene, float time)
+{
+	return scene ? scene->beginUpdate(time) : false;
+}
+
+abcrAPI bool endUpdate(abcrScene* scene)
+{
+	return scene ? scene->endUpdate() : false;
+}
+
+abcrAPI void updateTimeBudgeted(abcrScene* scene, float time, float budget)
+{
+	if (scene) scene->updateBudgeted(time, budget);
+}
+
+abcrAPI bool setGeomPriority(abcrScene* scene, const char* name, float priority)
+{
+	return scene ? scene->setPriority(name, priority) : false;
+}
+
+abcrAPI bool getGeomStaleness(abcrScene* scene, const char* name, int* frames, float* sampleTime)
+{
+	*frames = 0;
+	*sampleTime = 0;
+	return scene ? scene->getStaleness(name, frames, sampleTime) : false;
+}
+
+abcrAPI float getLastUpdateDuration(abcrScene* scene)
+{
+	return scene ? scene->getLastUpdateDuration() : -1;
+}
+
 abcrAPI void setInterpolate(abcrScene* scene, bool interpolate)
 {
 	if (scene) scene->setInterpolate(interpolate);
 }
 
+abcrAPI void setExtrapolate(abcrScene* scene, bool extrapolate)
+{
+	if (scene) scene->setExtrapolate(extrapolate);
+}
+
 abcrAPI AlembicType::Type getType(abcrGeom* geom)
 {
 	return geom ? geom->getType() : AlembicType::UNKNOWN;
@@ -66,6 +119,23 @@ abcrAPI float getGeomMaxTime(abcrGeom* geom)
 	return geom ? geom->getMaxTime() : -1;
 }
 
+abcrAPI int getAttributeCount(abcrGeom* geom)
+{
+	return geom ? (int)geom->getAttributeNames().size() : 0;
+}
+
+abcrAPI const char* getAttributeName(abcrGeom* geom, int index)
+{
+	if (!geom || index < 0 || index >= (int)geom->getAttributeNames().size()) return "";
+	return geom->getAttributeNames()[index].c_str();
+}
+
+abcrAPI bool getAttribute(abcrGeom* geom, const char* name, AttributeStream* o)
+{
+	*o = AttributeStream();
+	return geom ? geom->getAttribute(name, o) : false;
+}
+
 abcrAPI void getPointSample(Points* points, float* o)
 {
 	if (points) points->get(o);
@@ -76,9 +146,45 @@ abcrAPI int getPointCount(Points* points)
 	return points ? points->getPointCount() : -1;
 }
 
-abcrAPI void getCurveSample(Curves* curves, DataPointer* curvePtr, DataPointer* idxPtr)
+abcrAPI int getPointSourceCount(Points* points)
+{
+	return points ? points->getSourcePointCount() : -1;
+}
+
+abcrAPI void setPointLOD(Points* points, float fraction)
+{
+	if (points) points->setLOD(fraction);
+}
+
+abcrAPI void setPointSpatialIndex(Points* points, bool enable)
+{
+	if (points) points->setSpatialIndex(enable);
+}
+
+abcrAPI int queryPointsRadius(Points* points, Vector3 center, float radius, int maxCount, int* indices, float* distances)
+{
+	return points ? points->queryRadius(V3f(center.x, center.y, center.z), radius, maxCount, indices, distances) : 0;
+}
+
+abcrAPI int queryPointsNearest(Points* points, Vector3 center, int k, int* indices, float* distances)
+{
+	return points ? points->queryNearest(V3f(center.x, center.y, center.z), k, indices, distances) : 0;
+}
+
+abcrAPI bool getCurveSample(Curves* curves, DataPointer* curvePtr, DataPointer* idxPtr)
+{
+	return curves ? curves->get(curvePtr, idxPtr) : false;
+}
+
+abcrAPI void setCurveSubdivision(Curves* curves, int subdivision)
+{
+	if (curves) curves->setSubdivision(subdivision);
+}
+
+abcrAPI bool getCurveTessellatedSample(Curves* curves, CurveTessellation::Mode mode, int sides, float widthScale, Vector3 view,
+	DataPointer* geomPtr, DataPointer* idxPtr)
 {
-	if (curves) curves->get(curvePtr, idxPtr);
+	return curves ? curves->getTessellated(mode, sides, widthScale, V3f(view.x, view.y, view.z), geomPtr, idxPtr) : false;
 }
 
 abcrAPI VertexLayout getPolyMeshLayout(PolyMesh* mesh)
@@ -96,6 +202,83 @@ abcrAPI float* getPolyMeshSample(PolyMesh* mesh, int* size)
 	return mesh ? mesh->get(size) : nullptr;
 }
 
+abcrAPI void setPolyMeshCompact(PolyMesh* mesh, bool compact)
+{
+	if (mesh) mesh->setCompact(compact);
+}
+
+abcrAPI void setPolyMeshDirtyTracking(PolyMesh* mesh, bool track)
+{
+	if (mesh) mesh->setDirtyTracking(track);
+}
+
+abcrAPI void setPolyMeshSmoothNormals(PolyMesh* mesh, bool smooth, float hardEdgeAngle)
+{
+	if (mesh) mesh->setSmoothNormals(smooth, hardEdgeAngle);
+}
+
+abcrAPI void setPolyMeshTangents(PolyMesh* mesh, bool tangents)
+{
+	if (mesh) mesh->setTangents(tangents);
+}
+
+abcrAPI void setPolyMeshSplitStreams(PolyMesh* mesh, bool split)
+{
+	if (mesh) mesh->setSplitStreams(split);
+}
+
+abcrAPI bool isPolyMeshSplit(PolyMesh* mesh)
+{
+	return mesh ? mesh->isSplit() : false;
+}
+
+abcrAPI int getPolyMeshStreamMask(PolyMesh* mesh, bool dynamic)
+{
+	return mesh ? mesh->getStreamMask(dynamic) : 0;
+}
+
+abcrAPI bool getPolyMeshSplitSample(PolyMesh* mesh, DataPointer* dynamicPtr, DataPointer* staticPtr)
+{
+	*dynamicPtr = *staticPtr = DataPointer(nullptr, 0);
+	if (!mesh || !mesh->isSplit()) return false;
+
+	int size = 0;
+	float* dynamicStream = mesh->getSplit(&size);
+	*dynamicPtr = DataPointer(dynamicStream, size);
+
+	const float* staticStream = mesh->getStaticStream(&size);
+	*staticPtr = DataPointer(const_cast<float*>(staticStream), size);
+
+	return mesh->isStaticStreamWritten();
+}
+
+abcrAPI int getPolyMeshFaceSetCount(PolyMesh* mesh)
+{
+	return mesh ? (int)mesh->getFaceSets().size() : 0;
+}
+
+abcrAPI const char* getPolyMeshFaceSetName(PolyMesh* mesh, int index)
+{
+	if (!mesh || index < 0 || index >= (int)mesh->getFaceSets().size()) return "";
+	return mesh->getFaceSets()[index].Name.c_str();
+}
+
+abcrAPI bool getPolyMeshFaceSetRange(PolyMesh* mesh, int index, int* first, int* count)
+{
+	*first = *count = 0;
+	if (!mesh || index < 0 || index >= (int)mesh->getFaceSets().size()) return false;
+
+	*first = mesh->getFaceSets()[index].First;
+	*count = mesh->getFaceSets()[index].Count;
+	return true;
+}
+
+abcrAPI const DataRange* getPolyMeshDirtyRanges(PolyMesh* mesh, int* count)
+{
+	*count = 0;
+	return mesh ? mesh->getDirtyRanges(count) : nullptr;
+}
+
 abcrAPI BoundingBox getPolyMeshBoundingBox(PolyMesh* mesh)
 {
 	return mesh ? mesh->getBounds() : BoundingBox();
@@ -121,6 +304,44 @@ abcrAPI void getCameraSample(Camera* camera, Matrix4x4* v, CameraParam* p)
 	if (camera) camera->get(v, p);
 }
 
+abcrAPI VATBaker* bakeVertexAnimation(abcrScene* scene, const char* name, float startTime, float endTime,
+	int fps, int textureWidth, bool interpolate, VATEncoding::Type encoding, bool rigid, float tolerance)
+{
+	if (!scene) return nullptr;
+
+	auto* baker = new VATBaker(scene->getPath(), name);
+	if (baker->bake(startTime, endTime, fps, textureWidth, interpolate, encoding, rigid, tolerance)) return baker;
+
+	delete baker;
+	return nullptr;
+}
+
+abcrAPI VATInfo getVATInfo(VATBaker* baker)
+{
+	return baker ? baker->getInfo() : VATInfo();
+}
+
+abcrAPI void getVATTextures(VATBaker* baker, DataPointer* positionPtr, DataPointer* normalPtr)
+{
+	if (baker) baker->get(positionPtr, normalPtr);
+}
+
+abcrAPI const float* getVATFrameRemap(VATBaker* baker, int* count)
+{
+	*count = 0;
+	return baker ? baker->getFrameRemap(count) : nullptr;
+}
+
+abcrAPI void getVATRestData(VATBaker* baker, DataPointer* positionPtr, DataPointer* normalPtr)
+{
+	if (baker) baker->getRest(positionPtr, normalPtr);
+}
+
+abcrAPI void closeVAT(VATBaker* baker)
+{
+	if (baker) delete baker;
+}
+
 abcrAPI void RegisterDebugFunc(DebugFunction fp)
 {
 	RegisterDebugFunction(fp);
@@ -1,6 +1,7 @@
 #pragma once
 #include "abcr.h"
 #include "abcrScene.h"
+#include "abcrVAT.h"
 #include "abcrUtils.h"
 
 using namespace std;
@@ -10,6 +11,8 @@ using namespace Alembic::Abc;
 
 abcrAPI abcrScene* openScene(const char* path);
 
+abcrAPI abcrScene* openCursor(abcrScene* source);
+
 abcrAPI void closeScene(abcrScene* scene);
 
 abcrAPI float getMinTime(abcrScene* scene);
@@ -24,6 +27,24 @@ abcrAPI abcrGeom* getGeom(abcrScene* scene, const char* name);
 
 abcrAPI void updateTime(abcrScene* scene, float time);
 
+abcrAPI void updateFrame(abcrScene* scene, int frame, float fps);
+
+abcrAPI bool beginUpdate(abcrScene* scene, float time);
+
+abcrAPI bool endUpdate(abcrScene* scene);
+
+abcrAPI void updateTimeBudgeted(abcrScene* scene, float time, float budget);
+
+abcrAPI bool setGeomPriority(abcrScene* scene, const char* name, float priority);
+
+abcrAPI bool getGeomStaleness(abcrScene* scene, const char* name, int* frames, float* sampleTime);
+
+abcrAPI float getLastUpdateDuration(abcrScene* scene);
+
+abcrAPI void setInterpolate(abcrScene* scene, bool interpolate);
+
+abcrAPI void setExtrapolate(abcrScene* scene, bool extrapolate);
+
 abcrAPI AlembicType::Type getType(abcrGeom* geom);
 
 abcrAPI Matrix4x4 getTransform(abcrGeom* geom);
@@ -32,16 +53,61 @@ abcrAPI float getGeomMinTime(abcrGeom* geom);
 
 abcrAPI float getGeomMaxTime(abcrGeom* geom);
 
+abcrAPI int getAttributeCount(abcrGeom* geom);
+
+abcrAPI const char* getAttributeName(abcrGeom* geom, int index);
+
+abcrAPI bool getAttribute(abcrGeom* geom, const char* name, AttributeStream* o);
+
 abcrAPI void getPointSample(Points* points, float* o);
 
 abcrAPI int getPointCount(Points* points);
 
-abcrAPI void getCurveSample(Curves* curves, DataPointer* curvePtr, DataPointer* idxPtr);
+abcrAPI int getPointSourceCount(Points* points);
+
+abcrAPI void setPointLOD(Points* points, float fraction);
+
+abcrAPI void setPointSpatialIndex(Points* points, bool enable);
+
+abcrAPI int queryPointsRadius(Points* points, Vector3 center, float radius, int maxCount, int* indices, float* distances);
+
+abcrAPI int queryPointsNearest(Points* points, Vector3 center, int k, int* indices, float* distances);
+
+abcrAPI bool getCurveSample(Curves* curves, DataPointer* curvePtr, DataPointer* idxPtr);
+
+abcrAPI void setCurveSubdivision(Curves* curves, int subdivision);
+
+abcrAPI bool getCurveTessellatedSample(Curves* curves, CurveTessellation::Mode mode, int sides, float widthScale, Vector3 view,
+	DataPointer* geomPtr, DataPointer* idxPtr);
 
 abcrAPI VertexLayout getPolyMeshLayout(PolyMesh* mesh);
 
 abcrAPI float* getPolyMeshSample(PolyMesh* mesh, int* size);
 
+abcrAPI void setPolyMeshCompact(PolyMesh* mesh, bool compact);
+
+abcrAPI void setPolyMeshDirtyTracking(PolyMesh* mesh, bool track);
+
+abcrAPI void setPolyMeshSmoothNormals(PolyMesh* mesh, bool smooth, float hardEdgeAngle);
+
+abcrAPI void setPolyMeshTangents(PolyMesh* mesh, bool tangents);
+
+abcrAPI void setPolyMeshSplitStreams(PolyMesh* mesh, bool split);
+
+abcrAPI bool isPolyMeshSplit(PolyMesh* mesh);
+
+abcrAPI int getPolyMeshStreamMask(PolyMesh* mesh, bool dynamic);
+
+abcrAPI bool getPolyMeshSplitSample(PolyMesh* mesh, DataPointer* dynamicPtr, DataPointer* staticPtr);
+
+abcrAPI int getPolyMeshFaceSetCount(PolyMesh* mesh);
+
+abcrAPI const char* getPolyMeshFaceSetName(PolyMesh* mesh, int index);
+
+abcrAPI bool getPolyMeshFaceSetRange(PolyMesh* mesh, int index, int* first, int* count);
+
+abcrAPI const DataRange* getPolyMeshDirtyRanges(PolyMesh* mesh, int* count);
+
 abcrAPI BoundingBox getPolyMeshBoundingBox(PolyMesh* mesh);
 
 abcrAPI int getPolyMeshMaxVertexCount(PolyMesh* mesh);
@@ -52,4 +118,17 @@ abcrAPI BoundingBox getPolyMeshMaxSizeBoudingBox(PolyMesh* mesh);
 
 abcrAPI void getCameraSample(Camera* camera, Matrix4x4* v, CameraParam* p);
 
+abcrAPI VATBaker* bakeVertexAnimation(abcrScene* scene, const char* name, float startTime, float endTime,
+	int fps, int textureWidth, bool interpolate, VATEncoding::Type encoding, bool rigid, float tolerance);
+
+abcrAPI VATInfo getVATInfo(VATBaker* baker);
+
+abcrAPI void getVATTextures(VATBaker* baker, DataPointer* positionPtr, DataPointer* normalPtr);
+
+abcrAPI const float* getVATFrameRemap(VATBaker* baker, int* count);
+
+abcrAPI void getVATRestData(VATBaker* baker, DataPointer* positionPtr, DataPointer* normalPtr);
+
+abcrAPI void closeVAT(VATBaker* baker);
+
 abcrAPI void RegisterDebugFunc(DebugFunction fp);
\ No newline at end of file
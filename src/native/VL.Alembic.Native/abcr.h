@@ -1,3 +1,11 @@
 #pragma once
 
-#define abcrAPI extern "C" __declspec(dllexport)
\ No newline at end of file
+#ifdef _WIN32
+#ifdef VLALEMBICNATIVE_EXPORTS
+#define abcrAPI extern "C" __declspec(dllexport)
+#else
+#define abcrAPI extern "C" __declspec(dllimport)
+#endif
+#else
+#define abcrAPI extern "C" __attribute__((visibility("default")))
+#endif
\ No newline at end of file
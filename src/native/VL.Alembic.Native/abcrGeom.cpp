@@ -4,11 +4,11 @@
 abcrGeom::abcrGeom() : _type(AlembicType::UNKNOWN), 
                     _minTime(std::numeric_limits<float>::infinity()), _maxTime(0) {}
 
-abcrGeom::abcrGeom(IObject obj)
+abcrGeom::abcrGeom(IObject obj, const shared_ptr<ObjectInfoCache>& infoCache)
     : _obj(obj), _type(AlembicType::UNKNOWN), _constant(false), 
     _minTime(std::numeric_limits<float>::infinity()), _maxTime(0)
 {
-    this->setUpNodeRecursive(_obj);
+    this->setUpNodeRecursive(_obj, infoCache);
 }
 
 abcrGeom::~abcrGeom()
@@ -18,7 +18,7 @@ abcrGeom::~abcrGeom()
     if (_obj) _obj.reset();
 }
 
-void abcrGeom::setUpNodeRecursive(IObject obj)
+void abcrGeom::setUpNodeRecursive(IObject obj, const shared_ptr<ObjectInfoCache>& infoCache)
 {
     size_t nChildren = obj.getNumChildren();
 
@@ -31,31 +31,31 @@ void abcrGeom::setUpNodeRecursive(IObject obj)
         if (AbcGeom::IXform::matches(head))
         {
             AbcGeom::IXform xform(obj.getChild(i));
-            _geom.reset( new XForm(xform));
+            _geom.reset( new XForm(xform, infoCache));
         }
         else if (AbcGeom::IPoints::matches(head))
         {
             AbcGeom::IPoints points(obj.getChild(i));
-            _geom.reset( new Points(points));
+            _geom.reset( new Points(points, infoCache));
         }
         else if (AbcGeom::ICurves::matches(head))
         {
             AbcGeom::ICurves curves(obj.getChild(i));
-            _geom.reset( new Curves(curves));
+            _geom.reset( new Curves(curves, infoCache));
         }
         else if (AbcGeom::IPolyMesh::matches(head))
         {
             AbcGeom::IPolyMesh pmesh(obj.getChild(i));
-            _geom.reset( new PolyMesh(pmesh));
+            _geom.reset( new PolyMesh(pmesh, infoCache));
         }
         else if (AbcGeom::ICamera::matches(head))
         {
             AbcGeom::ICamera camera(obj.getChild(i));
-            _geom.reset( new Camera(camera));
+            _geom.reset( new Camera(camera, infoCache));
         }
         else
         {
-            _geom.reset( new abcrGeom(obj.getChild(i)));
+            _geom.reset( new abcrGeom(obj.getChild(i), infoCache));
         }
 
         if (_geom && _geom->valid())
@@ -81,15 +81,163 @@ void abcrGeom::setUpDocRecursive(shared_ptr<abcrGeom>& obj, map<string, shared_p
         setUpDocRecursive(obj->_children[i], nameMap, fullnameMap);
 }
 
+SampleTime SampleTime::resolve(const TimeSamplingPtr& sampling, size_t numSamples, chrono_t time)
+{
+    SampleTime s;
+    if (!sampling || numSamples == 0) return s;
+
+    const index_t last = (index_t)numSamples - 1;
+    const AbcA::TimeSamplingType& type = sampling->getTimeSamplingType();
+
+    if (type.isUniform())
+    {
+        // O(1) for the common case, same epsilon as the floor / ceil of TimeSampling
+        const chrono_t start = sampling->getSampleTime(0);
+        const chrono_t f = (time - start) / type.getTimePerCycle();
+        const chrono_t eps = 1e-9;
+
+        s.floorIndex = std::max<index_t>(0, std::min(last, (index_t)floor(f + eps)));
+        s.ceilIndex = std::max<index_t>(0, std::min(last, (index_t)ceil(f - eps)));
+        s.nearIndex = std::max<index_t>(0, std::min(last, (index_t)floor(f + 0.5)));
+    }
+    else
+    {
+        s.floorIndex = sampling->getFloorIndex(time, numSamples).first;
+        s.ceilIndex = sampling->getCeilIndex(time, numSamples).first;
+        s.nearIndex = sampling->getNearIndex(time, numSamples).first;
+    }
+
+    s.floorTime = sampling->getSampleTime(s.floorIndex);
+    s.ceilTime = sampling->getSampleTime(s.ceilIndex);
+
+    return s;
+}
+
+namespace
+{
+    // longest frame table, anything longer resolves per update like setTime
+    const int64_t MaxFrameTableSize = 1 << 18;
+}
+
+void SampleResolver::addSampling(const TimeSamplingPtr& sampling, size_t numSamples)
+{
+    if (!sampling || numSamples == 0) return;
+
+    // the double buffered update registers the same samplings again on every swap
+    if (_samplings.emplace(make_pair(sampling.get(), numSamples), sampling).second) _tableFps = 0;
+}
+
+void SampleResolver::buildFrameTables(double fps)
+{
+    _frameTables.clear();
+    _tableFps = fps;
+
+    if (_samplings.empty()) return;
+
+    chrono_t minTime = numeric_limits<chrono_t>::max();
+    chrono_t maxTime = -numeric_limits<chrono_t>::max();
+
+    for (const auto& s : _samplings)
+    {
+        minTime = std::min(minTime, s.second->getSampleTime(0));
+        maxTime = std::max(maxTime, s.second->getSampleTime(s.first.second - 1));
+    }
+
+    const int64_t first = (int64_t)floor(minTime * fps);
+    const int64_t last = (int64_t)ceil(maxTime * fps);
+    if (last - first + 1 > MaxFrameTableSize) return;
+
+    _firstFrame = (int)first;
+    const int count = (int)(last - first + 1);
+
+    for (const auto& s : _samplings)
+    {
+        vector<SampleTime>& table = _frameTables[s.first];
+        table.resize(count);
+
+        #pragma omp parallel for
+        for (int i = 0; i < count; ++i)
+            table[i] = SampleTime::resolve(s.second, s.first.second, (double)(_firstFrame + i) / fps);
+    }
+}
+
+void SampleResolver::setFrame(int frame, double fps)
+{
+    if (fps <= 0) return;
+    if (fps != _tableFps) buildFrameTables(fps);
+
+    setTime((double)frame / fps);
+
+    _isFrame = true;
+    _frame = frame;
+}
+
+const SampleTime& SampleResolver::resolve(const TimeSamplingPtr& sampling, size_t numSamples)
+{
+    const SamplingKey key = make_pair(sampling.get(), numSamples);
+
+    if (_isFrame)
+    {
+        auto table = _frameTables.find(key);
+        if (table != _frameTables.end())
+        {
+            const int last = (int)table->second.size() - 1;
+            return table->second[std::max(0, std::min(last, _frame - _firstFrame))];
+        }
+    }
+
+    auto it = _cache.find(key);
+    if (it != _cache.end()) return it->second;
+
+    return _cache[key] = SampleTime::resolve(sampling, numSamples, _time);
+}
+
+void abcrGeom::setSampleResolver(SampleResolver* resolver)
+{
+    _resolver = resolver;
+    if (_resolver) _resolver->addSampling(_samplingPtr, _numSamples);
+
+    for (size_t i = 0; i < _children.size(); ++i)
+        _children[i]->setSampleResolver(resolver);
+}
+
+const SampleTime& abcrGeom::resolveSample(chrono_t time)
+{
+    if (_resolver && _resolver->getTime() == time)
+        return _resolver->resolve(_samplingPtr, _numSamples);
+
+    _sampleTime = SampleTime::resolve(_samplingPtr, _numSamples, time);
+    return _sampleTime;
+}
+
+ISampleSelector abcrGeom::getSampleSelector(chrono_t time, ISampleSelector::TimeIndexType type)
+{
+    const SampleTime& s = resolveSample(time);
+
+    if (type == ISampleSelector::kFloorIndex) return ISampleSelector(s.floorIndex);
+    if (type == ISampleSelector::kCeilIndex) return ISampleSelector(s.ceilIndex);
+    return ISampleSelector(s.nearIndex);
+}
+
+ISampleSelector abcrGeom::getPropertySelector(const ISampleSelector& ss, const TimeSamplingPtr& sampling) const
+{
+    if (!sampling || sampling == _samplingPtr || *sampling == *_samplingPtr) return ss;
+
+    return ISampleSelector(_samplingPtr->getSampleTime(ss.getRequestedIndex()));
+}
+
 void abcrGeom::getInterpolateSampleSelector(chrono_t time, ISampleSelector& ss0, ISampleSelector& ss1, chrono_t& t)
 {
     auto prevTime = _samplingPtr->getSampleTime(_lastSampleIndex);
+    const SampleTime& s = resolveSample(time);
 
-    ss0 = ISampleSelector(time, prevTime < time ? ISampleSelector::kFloorIndex : ISampleSelector::kCeilIndex);
-    ss1 = ISampleSelector(time, prevTime < time ? ISampleSelector::kCeilIndex : ISampleSelector::kFloorIndex);
+    const bool forward = prevTime < time;
+    const index_t index0 = forward ? s.floorIndex : s.ceilIndex;
+    const index_t index1 = forward ? s.ceilIndex : s.floorIndex;
 
-    auto index0 = ss0.getIndex(_samplingPtr, _numSamples);
-    auto index1 = ss1.getIndex(_samplingPtr, _numSamples);
+    ss0 = ISampleSelector(index0);
+    ss1 = ISampleSelector(index1);
+    _blendSampleIndex = index1;
 
     if (index0 == index1)
     {
@@ -97,13 +245,232 @@ void abcrGeom::getInterpolateSampleSelector(chrono_t time, ISampleSelector& ss0,
     }
     else
     {
-        auto time0 = _samplingPtr->getSampleTime(index0);
-        auto time1 = _samplingPtr->getSampleTime(index1);
+        auto time0 = forward ? s.floorTime : s.ceilTime;
+        auto time1 = forward ? s.ceilTime : s.floorTime;
 
         t = (time - time0) / (time1 - time0);
     }
 }
 
+const AbcA::PropertyHeader* abcrGeom::findAttribute(const string& name, ICompoundProperty& parent)
+{
+    ICompoundProperty props = getGeomProperties();
+    if (!props.valid()) return nullptr;
+
+    string key = name;
+    if (name == "id" || name == "ids") key = ".pointIds";
+    else if (name == "velocity" || name == "velocities" || name == "v") key = ".velocities";
+    else if (name == "width" || name == "widths") key = ".widths";
+
+    if (const AbcA::PropertyHeader* header = props.getPropertyHeader(key))
+    {
+        parent = props;
+        return header;
+    }
+
+    if (props.getPropertyHeader(".arbGeomParams"))
+    {
+        ICompoundProperty arb(props, ".arbGeomParams");
+        if (const AbcA::PropertyHeader* header = arb.getPropertyHeader(name))
+        {
+            parent = arb;
+            return header;
+        }
+    }
+
+    return nullptr;
+}
+
+// plain array properties and the .vals / .indices pair of indexed geom params
+static bool readAttribute(ICompoundProperty parent, const AbcA::PropertyHeader& header, const ISampleSelector& ss,
+    AbcA::ArraySamplePtr& vals, AbcA::ArraySamplePtr& indices)
+{
+    if (header.isArray())
+    {
+        IArrayProperty(parent, header.getName()).get(vals, ss);
+        return true;
+    }
+
+    if (!header.isCompound()) return false;
+
+    ICompoundProperty param(parent, header.getName());
+
+    const AbcA::PropertyHeader* valsHeader = param.getPropertyHeader(".vals");
+    if (!valsHeader || !valsHeader->isArray()) return false;
+
+    IArrayProperty(param, ".vals").get(vals, ss);
+
+    if (param.getPropertyHeader(".indices"))
+        IArrayProperty(param, ".indices").get(indices, ss);
+
+    return true;
+}
+
+static void expandIndices(const AbcA::ArraySamplePtr& vals, const AbcA::ArraySamplePtr& indices, vector<uint8_t>& o)
+{
+    const size_t elementSize = Alembic::Util::PODNumBytes(vals->getDataType().getPod()) * vals->getDataType().getExtent();
+    const size_t numVals = vals->size();
+    const size_t count = indices->size();
+    const uint32_t* idx = (const uint32_t*)indices->getData();
+    const uint8_t* src = (const uint8_t*)vals->getData();
+
+    o.resize(count * elementSize);
+
+    #pragma omp parallel for
+    for (int64_t i = 0; i < (int64_t)count; ++i)
+    {
+        if (idx[i] < numVals) memcpy(&o[i * elementSize], src + idx[i] * elementSize, elementSize);
+        else memset(&o[i * elementSize], 0, elementSize);
+    }
+}
+
+bool abcrGeom::getAttribute(const string& name, AttributeStream* o)
+{
+    *o = AttributeStream();
+
+    ICompoundProperty parent;
+    const AbcA::PropertyHeader* header = findAttribute(name, parent);
+    if (!header) return false;
+
+    // arbitrary params may have a TimeSampling of their own, indexed ones keep it on .vals
+    TimeSamplingPtr sampling = header->getTimeSampling();
+    if (!sampling && header->isCompound())
+    {
+        const AbcA::PropertyHeader* valsHeader = ICompoundProperty(parent, header->getName()).getPropertyHeader(".vals");
+        if (valsHeader) sampling = valsHeader->getTimeSampling();
+    }
+
+    ISampleSelector ss0 = getPropertySelector(ISampleSelector(_lastSampleIndex), sampling);
+
+    AbcA::ArraySamplePtr vals, indices;
+    if (!readAttribute(parent, *header, ss0, vals, indices) || !vals) return false;
+
+    const AbcA::DataType& dataType = vals->getDataType();
+    if (dataType.getPod() == Alembic::Util::kStringPOD || dataType.getPod() == Alembic::Util::kWstringPOD) return false;
+
+    const size_t elementSize = Alembic::Util::PODNumBytes(dataType.getPod()) * dataType.getExtent();
+
+    _attributeSamples[name] = vals;
+    vector<uint8_t>& buffer = _attributeBuffers[name];
+
+    const void* data = vals->getData();
+    size_t count = vals->size();
+
+    if (indices)
+    {
+        expandIndices(vals, indices, buffer);
+        data = buffer.data();
+        count = indices->size();
+    }
+
+    // only float attributes are blended, everything else is taken from the first sample like ids
+    const bool blend = _isInterpolate && _t > 0 && _blendSampleIndex != _lastSampleIndex &&
+        dataType.getPod() == Alembic::Util::kFloat32POD;
+
+    if (blend)
+    {
+        ISampleSelector ss1 = getPropertySelector(ISampleSelector(_blendSampleIndex), sampling);
+
+        AbcA::ArraySamplePtr vals2, indices2;
+        vector<uint8_t> expanded;
+
+        if (readAttribute(parent, *header, ss1, vals2, indices2) && vals2 && vals2->getDataType() == dataType)
+        {
+            const float* b = (const float*)vals2->getData();
+            size_t count2 = vals2->size();
+
+            if (indices2)
+            {
+                expandIndices(vals2, indices2, expanded);
+                b = (const float*)expanded.data();
+                count2 = indices2->size();
+            }
+
+            const vector<int>* match = getBlendMatch();
+            const bool matched = match && match->size() == count;
+
+            if (matched || count == count2)
+            {
+                const size_t extent = dataType.getExtent();
+                const float t = (float)_t;
+
+                // expanded indices are blended in place
+                if (!indices) buffer.resize(count * elementSize);
+
+                const float* a = (const float*)data;
+                float* dst = (float*)buffer.data();
+
+                #pragma omp parallel for
+                for (int64_t i = 0; i < (int64_t)count; ++i)
+                {
+                    const int j = matched ? (*match)[i] : (int)i;
+                    for (size_t k = 0; k < extent; ++k)
+                    {
+                        const float v = a[i * extent + k];
+                        dst[i * extent + k] = j < 0 ? v : v + (b[j * extent + k] - v) * t;
+                    }
+                }
+
+                data = buffer.data();
+            }
+        }
+    }
+
+    // same points as getPointCount and get
+    const vector<int>* selection = getPointSelection(count);
+    if (selection)
+    {
+        const vector<int>& sel = *selection;
+        const uint8_t* src = (const uint8_t*)data;
+
+        vector<uint8_t> compact(sel.size() * elementSize);
+
+        #pragma omp parallel for
+        for (int i = 0; i < (int)sel.size(); ++i)
+            memcpy(compact.data() + i * elementSize, src + sel[i] * elementSize, elementSize);
+
+        buffer.swap(compact);
+        data = buffer.data();
+        count = sel.size();
+    }
+
+    o->Pointer = const_cast<void*>(data);
+    o->Count = (int)count;
+    o->Size = (int)(count * elementSize);
+    o->Type = (int)dataType.getPod();
+    o->Extent = (int)dataType.getExtent();
+    o->Scope = (int)AbcGeom::GetGeometryScope(header->getMetaData());
+
+    return true;
+}
+
+const vector<string>& abcrGeom::getAttributeNames()
+{
+    if (!_attributeNames.empty()) return _attributeNames;
+
+    ICompoundProperty props = getGeomProperties();
+    if (!props.valid()) return _attributeNames;
+
+    for (size_t i = 0; i < props.getNumProperties(); ++i)
+    {
+        const AbcA::PropertyHeader& header = props.getPropertyHeader(i);
+        if (header.isArray() || (header.isCompound() && ICompoundProperty(props, header.getName()).getPropertyHeader(".vals")))
+            _attributeNames.push_back(header.getName());
+    }
+
+    if (props.getPropertyHeader(".arbGeomParams"))
+    {
+        ICompoundProperty arb(props, ".arbGeomParams");
+        for (size_t i = 0; i < arb.getNumProperties(); ++i)
+        {
+            const AbcA::PropertyHeader& header = arb.getPropertyHeader(i);
+            if (!props.getPropertyHeader(header.getName())) _attributeNames.push_back(header.getName());
+        }
+    }
+
+    return _attributeNames;
+}
+
 
 template<typename T>
 void abcrGeom::setMinMaxTime(T& obj)
@@ -120,19 +487,20 @@ void abcrGeom::setMinMaxTime(T& obj)
 
 void abcrGeom::updateTimeSample(chrono_t time, Imath::M44f& transform)
 {
-    set(time, transform);
+    if (!_skipSample) set(time, transform);
     _transform = transform;
 
     for (size_t i = 0; i < _children.size(); ++i)
     {
         Imath::M44f m = transform;
         _children[i]->setInterpolate(_isInterpolate);
+        _children[i]->setExtrapolate(_isExtrapolate);
         _children[i]->updateTimeSample(time, m);
     }
 }
 
-XForm::XForm(AbcGeom::IXform xform)
-    : abcrGeom(xform), _xform(xform)
+XForm::XForm(AbcGeom::IXform xform, const shared_ptr<ObjectInfoCache>& infoCache)
+    : abcrGeom(xform, infoCache), _xform(xform)
 {
     _type = AlembicType::XFORM;
     setMinMaxTime(_xform);
@@ -186,7 +554,7 @@ void XForm::set(chrono_t time, Imath::M44f& transform)
         }
         else
         {
-            ISampleSelector ss(time, ISampleSelector::kNearIndex);
+            ISampleSelector ss = getSampleSelector(time, ISampleSelector::kNearIndex);
 
             const Imath::M44d& m = _xform.getSchema().getValue(ss).getMatrix();
             const double* src = m.getValue();
@@ -201,8 +569,8 @@ void XForm::set(chrono_t time, Imath::M44f& transform)
     transform = _matrix * transform;
 }
 
-Points::Points(AbcGeom::IPoints points)
-    : abcrGeom(points), _points(points)
+Points::Points(AbcGeom::IPoints points, const shared_ptr<ObjectInfoCache>& infoCache)
+    : abcrGeom(points, infoCache), _points(points)
 {
     _type = AlembicType::POINTS;
     setMinMaxTime(_points);
@@ -224,6 +592,12 @@ void Points::set(chrono_t time, Imath::M44f& transform)
     AbcGeom::IPointsSchema ptSchema = _points.getSchema();
     AbcGeom::IPointsSchema::Sample pts_sample, pts_sample2;
 
+    const bool extrapolate = _isExtrapolate && ptSchema.getVelocitiesProperty().valid();
+    if (extrapolate) _isInterpolate = false;
+
+    _velocities.reset();
+    _dt = 0;
+
     if (_isInterpolate)
     {
         ISampleSelector ss0, ss1;
@@ -234,36 +608,232 @@ void Points::set(chrono_t time, Imath::M44f& transform)
         _positions = pts_sample.getPositions();
         _positions2 = pts_sample2.getPositions();
 
+        _ids = pts_sample.getIds();
+        _ids2 = pts_sample2.getIds();
+
         _lastSampleIndex = ss0.getIndex(_samplingPtr, _numSamples);
 
-        _isInterpolate = _positions->size() == _positions2->size();
+        _isInterpolate = this->matchIds();
     }
 
     if(!_isInterpolate)
     {
-        ISampleSelector ss(time, ISampleSelector::kNearIndex);
+        ISampleSelector ss = getSampleSelector(time, extrapolate ? ISampleSelector::kFloorIndex : ISampleSelector::kNearIndex);
         ptSchema.get(pts_sample, ss);
         _positions = pts_sample.getPositions();
+        if (_lodFraction < 1) _ids = pts_sample.getIds();
 
         _lastSampleIndex = ss.getIndex(_samplingPtr, _numSamples);
+
+        if (extrapolate)
+        {
+            _velocities = pts_sample.getVelocities();
+            _dt = (float)(time - _samplingPtr->getSampleTime(_lastSampleIndex));
+        }
+    }
+
+    if (_lodSampleIndex != (int64_t)_lastSampleIndex) selectLOD();
+
+    if (_useSpatialIndex) updateSpatialIndex();
+}
+
+void Points::setLOD(float fraction)
+{
+    fraction = std::max(0.0f, std::min(1.0f, fraction));
+    if (fraction == _lodFraction) return;
+
+    _lodFraction = fraction;
+    _lodSampleIndex = -1;
+    _gridSampleIndex = -1;
+
+    // select right away so the count and the indices match the current sample before the next update.
+    // set only reads the ids while a LOD is on, so they are read here for the shown sample
+    if (_positions)
+    {
+        Abc::IUInt64ArrayProperty ids = _points.getSchema().getIdsProperty();
+        if (_lodFraction < 1 && ids.valid()) ids.get(_ids, ISampleSelector((index_t)_lastSampleIndex));
+
+        selectLOD();
+    }
+}
+
+void Points::selectLOD()
+{
+    const int n = (int)_positions->size();
+
+    _lodSampleIndex = (int64_t)_lastSampleIndex;
+
+    if (_lodFraction >= 1)
+    {
+        _lodIndices.clear();
+        _pointCount = n;
+        return;
+    }
+
+    const uint64_t* ids = _ids && _ids->size() == (size_t)n ? _ids->get() : nullptr;
+    const uint64_t threshold = (uint64_t)(_lodFraction * 16777216.0);
+
+    int numThreads = 1;
+#ifdef _OPENMP
+    numThreads = omp_get_max_threads();
+#endif
+
+    // count per chunk, then every chunk writes its kept indices in order
+    vector<int> counts(numThreads + 1, 0);
+
+    #pragma omp parallel for
+    for (int c = 0; c < numThreads; ++c)
+    {
+        const int begin = (int)((int64_t)n * c / numThreads);
+        const int end = (int)((int64_t)n * (c + 1) / numThreads);
+        for (int i = begin; i < end; ++i)
+            if ((mixHash(ids ? ids[i] : (uint64_t)i) >> 40) < threshold) ++counts[c + 1];
+    }
+
+    for (int c = 0; c < numThreads; ++c) counts[c + 1] += counts[c];
+
+    _lodIndices.resize(counts[numThreads]);
+
+    #pragma omp parallel for
+    for (int c = 0; c < numThreads; ++c)
+    {
+        const int begin = (int)((int64_t)n * c / numThreads);
+        const int end = (int)((int64_t)n * (c + 1) / numThreads);
+        int k = counts[c];
+        for (int i = begin; i < end; ++i)
+            if ((mixHash(ids ? ids[i] : (uint64_t)i) >> 40) < threshold) _lodIndices[k++] = i;
     }
 
-    _pointCount = _positions->size();
+    _pointCount = (int)_lodIndices.size();
+}
+
+void Points::copySettings(const abcrGeom& source)
+{
+    const Points& o = static_cast<const Points&>(source);
+
+    setLOD(o._lodFraction);
+    if (o._useSpatialIndex != _useSpatialIndex) setSpatialIndex(o._useSpatialIndex);
+}
+
+void Points::setSpatialIndex(bool enable)
+{
+    _useSpatialIndex = enable;
+    _gridSampleIndex = -1;
+
+    if (!enable)
+    {
+        _grid.clear();
+        vector<V3f>().swap(_gridPositions);
+    }
+}
+
+void Points::updateSpatialIndex()
+{
+    const double t = _isInterpolate ? _t : 0;
+    if (_gridSampleIndex == (int64_t)_lastSampleIndex && _gridT == t && _gridDt == _dt) return;
+
+    _gridPositions.resize(_pointCount);
+    if (_pointCount > 0) get(reinterpret_cast<float*>(_gridPositions.data()));
+
+    _grid.build(_gridPositions.data(), _pointCount);
+
+    _gridSampleIndex = (int64_t)_lastSampleIndex;
+    _gridT = t;
+    _gridDt = _dt;
+}
+
+int Points::queryRadius(const V3f& center, float radius, int maxCount, int* oindices, float* odistances)
+{
+    if (!_useSpatialIndex) return 0;
+
+    updateSpatialIndex();
+    return _grid.queryRadius(center, radius, maxCount, oindices, odistances);
+}
+
+int Points::queryNearest(const V3f& center, int k, int* oindices, float* odistances)
+{
+    if (!_useSpatialIndex) return 0;
+
+    updateSpatialIndex();
+    return _grid.queryNearest(center, k, oindices, odistances);
+}
+
+bool Points::matchIds()
+{
+    const size_t n0 = _positions->size();
+    const size_t n1 = _positions2->size();
+
+    _matchIndex.clear();
+
+    const bool hasIds = _ids && _ids2 && _ids->size() == n0 && _ids2->size() == n1;
+    if (!hasIds) return n0 == n1;
+
+    const uint64_t* id0 = _ids->get();
+    const uint64_t* id1 = _ids2->get();
+
+    // particles that survive usually keep their order
+    if (n0 == n1 && memcmp(id0, id1, n0 * sizeof(uint64_t)) == 0) return true;
+
+    _sortedIds.resize(n1);
+
+    #pragma omp parallel for
+    for (int64_t j = 0; j < (int64_t)n1; ++j)
+        _sortedIds[j] = make_pair(id1[j], (int)j);
+
+    parallelSort(_sortedIds);
+
+    _matchIndex.resize(n0);
+
+    #pragma omp parallel for
+    for (int64_t i = 0; i < (int64_t)n0; ++i)
+    {
+        auto it = std::lower_bound(_sortedIds.begin(), _sortedIds.end(), make_pair(id0[i], std::numeric_limits<int>::min()));
+        _matchIndex[i] = (it != _sortedIds.end() && it->first == id0[i]) ? it->second : -1;
+    }
+
+    return true;
 }
 
 bool Points::get(float* o)
 {
     const V3f* src = _positions->get();
+    V3f* dst = reinterpret_cast<V3f*>(o);
+
+    // source index of every returned point, nullptr when every point is returned
+    const int* lod = _lodFraction < 1 ? _lodIndices.data() : nullptr;
 
     if (_isInterpolate)
     {
         const V3f* src2 = _positions2->get();
 
-        for (size_t i = 0; i < _pointCount; ++i)
+        const float t = (float)_t;
+        const int* match = _matchIndex.empty() ? nullptr : _matchIndex.data();
+
+        #pragma omp parallel for
+        for (int k = 0; k < _pointCount; ++k)
+        {
+            const int i = lod ? lod[k] : k;
+            const int j = match ? match[i] : i;
+            dst[k] = j < 0 ? src[i] : src[i] * (1 - t) + src2[j] * t;
+        }
+    }
+    else if (_velocities && _velocities->size() == _positions->size())
+    {
+        const V3f* vel = _velocities->get();
+
+        #pragma omp parallel for
+        for (int k = 0; k < _pointCount; ++k)
         {
-            copyTo(o, src[i] * (1 - _t) + src2[i] * _t);
+            const int i = lod ? lod[k] : k;
+            dst[k] = src[i] + vel[i] * _dt;
         }
     }
+    else if (lod)
+    {
+        #pragma omp parallel for
+        for (int k = 0; k < _pointCount; ++k)
+            dst[k] = src[lod[k]];
+    }
     else
     {
         memcpy(o, src, this->getPointCount() * sizeof(V3f));
@@ -272,8 +842,8 @@ bool Points::get(float* o)
     return true;
 }
 
-Curves::Curves(AbcGeom::ICurves curves)
-    : abcrGeom(curves), _curves(curves)
+Curves::Curves(AbcGeom::ICurves curves, const shared_ptr<ObjectInfoCache>& infoCache)
+    : abcrGeom(curves, infoCache), _curves(curves)
 {
     _type = AlembicType::CURVES;
     setMinMaxTime(curves);
@@ -303,13 +873,17 @@ void Curves::set(chrono_t time, Imath::M44f& transform)
         curvSchema.get(_curveSample, ss0);
         curvSchema.get(_curveSample2, ss1);
 
+        _hasNumVerticesKey = curvSchema.getNumVerticesProperty().getKey(_numVerticesKey, ss0);
+
         _lastSampleIndex = ss0.getIndex(_samplingPtr, _numSamples);
     }
     else
     {
-        ISampleSelector ss(time, ISampleSelector::kNearIndex);
+        ISampleSelector ss = getSampleSelector(time, ISampleSelector::kNearIndex);
         curvSchema.get(_curveSample, ss);
 
+        _hasNumVerticesKey = curvSchema.getNumVerticesProperty().getKey(_numVerticesKey, ss);
+
         _lastSampleIndex = ss.getIndex(_samplingPtr, _numSamples);
     }
 }
@@ -333,97 +907,394 @@ void Curves::resizeGeom(size_t size)
     {
         size = std::max<size_t>(size, (size_t)_pointCount * 2);
 
-        if (_index != nullptr) delete[] _geom;
+        if (_geom != nullptr) delete[] _geom;
 
         _geom = new float[size * 3];
         _pointCapacity = size;
     }
 }
 
-void Curves::get(DataPointer* ocurve, DataPointer* oidx)
+const V3f* Curves::evaluatePositions()
 {
     P3fArraySamplePtr positions = _curveSample.getPositions();
+    _pointCount = (int)positions->size();
+    _curveCount = (int)_curveSample.getNumCurves();
+    _numVertices = _curveSample.getCurvesNumVertices()->get();
 
-    size_t nCurves = _curveSample.getNumCurves();
-    const Alembic::Util::int32_t* nVertices = _curveSample.getCurvesNumVertices()->get();
+    if (!_isInterpolate) return this->refine(positions->get());
 
-    _indexCount = 0;
-    for (size_t i = 0; i < nCurves; ++i)
-    {
-        _indexCount += nVertices[i] * 2 - 2;
-    }
+    this->resizeGeom(_pointCount);
 
-    _pointCount = positions->size();
+    const V3f* pts = positions->get();
+    const V3f* pts2 = _curveSample2.getPositions()->get();
 
-    this->resizeIndex(_indexCount);
-    this->resizeGeom(_pointCount);
+    V3f* dst = reinterpret_cast<V3f*>(_geom);
+    const float t = (float)_t;
 
-    int cnt = 0;
-    int cnt2 = 0;
-    for (size_t i = 0; i < nCurves; ++i)
+    #pragma omp parallel for
+    for (int i = 0; i < _pointCount; ++i)
     {
-        const int num = nVertices[i];
-
-        for (size_t j = 0; j < num - (size_t)1; ++j)
-        {
-            int idx = cnt2 + j;
-            _index[cnt++] = (uint32_t)idx + 0;
-            _index[cnt++] = (uint32_t)idx + 1;
-        }
-        cnt2 += num;
+        dst[i] = pts[i] * (1 - t) + pts2[i] * t;
     }
 
-    *oidx  = DataPointer(_index, _indexCount * 4);
+    return this->refine(reinterpret_cast<const V3f*>(_geom));
+}
 
-    if (_isInterpolate)
+static int cubicSpanCount(AbcGeom::BasisType basis, int count, bool periodic)
+{
+    switch (basis)
     {
-        P3fArraySamplePtr positions2 = _curveSample2.getPositions();
-
-        const V3f* pts = positions->get();
-        const V3f* pts2 = positions2->get();
+    case AbcGeom::kBezierBasis:
+        return periodic ? count / 3 : (count - 1) / 3;
+    case AbcGeom::kHermiteBasis:
+        return periodic ? count / 2 : (count - 2) / 2;
+    case AbcGeom::kBsplineBasis:
+    case AbcGeom::kCatmullromBasis:
+        return periodic ? count : count - 3;
+    default:
+        return 0;
+    }
+}
+
+static int cubicSpanStep(AbcGeom::BasisType basis)
+{
+    return basis == AbcGeom::kBezierBasis ? 3 : basis == AbcGeom::kHermiteBasis ? 2 : 1;
+}
+
+// evaluate the curve basis into _refined, curves that can't be evaluated are passed through
+const V3f* Curves::refine(const V3f* pts)
+{
+    const AbcGeom::CurveType type = _curveSample.getType();
+    const AbcGeom::BasisType basis = _curveSample.getBasis();
+    const bool periodic = _curveSample.getWrap() == AbcGeom::kPeriodic;
+
+    const Alembic::Util::uint8_t* orders = _curveSample.getOrders() ? _curveSample.getOrders()->get() : nullptr;
+    const float* knots = _curveSample.getKnots() ? _curveSample.getKnots()->get() : nullptr;
+    const float* weights = _curveSample.getPositionWeights() && (int)_curveSample.getPositionWeights()->size() == _pointCount ?
+        _curveSample.getPositionWeights()->get() : nullptr;
+
+    const bool nurbs = type == AbcGeom::kVariableOrder && orders != nullptr && knots != nullptr;
+    const bool cubic = type == AbcGeom::kCubic && basis != AbcGeom::kNoBasis && basis != AbcGeom::kPowerBasis;
 
-        for (size_t i = 0; i < _pointCount; ++i)
+    if (_subdivision < 1 || !(nurbs || cubic)) return pts;
+
+    const int nCurves = _curveCount;
+    const int sub = _subdivision;
+
+    _refinedNumVertices.resize(nCurves);
+    _refinedOffsets.resize(nCurves + 1);
+    _sourceOffsets.resize(nCurves + 1);
+    _knotOffsets.resize(nCurves + 1);
+    _refinedOffsets[0] = _sourceOffsets[0] = _knotOffsets[0] = 0;
+
+    for (int i = 0; i < nCurves; ++i)
+    {
+        const int n = _numVertices[i];
+        const int order = nurbs ? orders[i] : 4;
+        const int spans = nurbs ? (order > 2 && order <= 16 ? n - order + 1 : 0) : cubicSpanCount(basis, n, periodic);
+
+        _refinedNumVertices[i] = spans > 0 ? spans * sub + 1 : n;
+        _refinedOffsets[i + 1] = _refinedOffsets[i] + _refinedNumVertices[i];
+        _sourceOffsets[i + 1] = _sourceOffsets[i] + n;
+        _knotOffsets[i + 1] = _knotOffsets[i] + (nurbs ? n + order : 0);
+    }
+
+    _refined.resize(_refinedOffsets[nCurves]);
+
+    // cubic weights are the same for every span
+    vector<float> table((sub + 1) * 4);
+    for (int k = 0; k <= sub; ++k) cubicBasisWeights(basis, (float)k / sub, &table[k * 4]);
+
+    #pragma omp parallel for
+    for (int i = 0; i < nCurves; ++i)
+    {
+        const int n = _numVertices[i];
+        const V3f* src = pts + _sourceOffsets[i];
+        V3f* dst = _refined.data() + _refinedOffsets[i];
+
+        const int order = nurbs ? orders[i] : 4;
+        const int spans = nurbs ? (order > 2 && order <= 16 ? n - order + 1 : 0) : cubicSpanCount(basis, n, periodic);
+
+        if (spans <= 0)
         {
-            copyTo(_geom, pts[i] * (1 - _t) + pts2[i] * _t);
+            for (int j = 0; j < n; ++j) dst[j] = src[j];
         }
+        else if (nurbs)
+        {
+            const float* knot = knots + _knotOffsets[i];
+            const float* weight = weights != nullptr ? weights + _sourceOffsets[i] : nullptr;
+            const float begin = knot[order - 1];
+            const float end = knot[n];
+
+            for (int k = 0; k <= spans * sub; ++k)
+            {
+                dst[k] = evaluateNurbs(src, weight, knot, n, order, begin + (end - begin) * k / (spans * sub));
+            }
+        }
+        else
+        {
+            const int step = cubicSpanStep(basis);
 
-        *ocurve = DataPointer((void*)_geom, (int)positions->size() * 4 * 3);
+            for (int s = 0; s < spans; ++s)
+            {
+                const V3f& p0 = src[(s * step + 0) % n];
+                const V3f& p1 = src[(s * step + 1) % n];
+                const V3f& p2 = src[(s * step + 2) % n];
+                const V3f& p3 = src[(s * step + 3) % n];
+
+                const int last = s == spans - 1 ? sub : sub - 1;
+                for (int k = 0; k <= last; ++k)
+                {
+                    const float* w = &table[k * 4];
+                    dst[s * sub + k] = p0 * w[0] + p1 * w[1] + p2 * w[2] + p3 * w[3];
+                }
+            }
+        }
     }
-    else
+
+    _numVertices = _refinedNumVertices.data();
+    _pointCount = (int)_refined.size();
+
+    return _refined.data();
+}
+
+void Curves::copyHistory(const abcrGeom& source)
+{
+    const Curves& o = static_cast<const Curves&>(source);
+
+    // the index buffers hold their own key, rebuild them when the front showed another one
+    if (!o._hasIndex || !_hasIndex || !(o._indexKey == _indexKey) || o._indexSubdivision != _indexSubdivision)
+        _hasIndex = false;
+
+    if (!o._hasTessIndex || !_hasTessIndex || !(o._tessIndexKey == _tessIndexKey) || o._tessRing != _tessRing
+        || o._tessSubdivision != _tessSubdivision)
+        _hasTessIndex = false;
+}
+
+bool Curves::get(DataPointer* ocurve, DataPointer* oidx)
+{
+    const V3f* pts = this->evaluatePositions();
+
+    // index buffer only depends on the num vertices sample
+    bool indexUnchanged = _hasIndex && _hasNumVerticesKey && _numVerticesKey == _indexKey && _indexSubdivision == _subdivision;
+
+    if (!indexUnchanged)
     {
-        *ocurve = DataPointer((void*)positions->get(), (int)positions->size() * 4 * 3);
+        size_t nCurves = _curveCount;
+        const Alembic::Util::int32_t* nVertices = _numVertices;
+
+        _indexCount = 0;
+        for (size_t i = 0; i < nCurves; ++i)
+        {
+            _indexCount += nVertices[i] * 2 - 2;
+        }
+
+        this->resizeIndex(_indexCount);
+
+        int cnt = 0;
+        int cnt2 = 0;
+        for (size_t i = 0; i < nCurves; ++i)
+        {
+            const int num = nVertices[i];
+
+            for (size_t j = 0; j < num - (size_t)1; ++j)
+            {
+                int idx = cnt2 + j;
+                _index[cnt++] = (uint32_t)idx + 0;
+                _index[cnt++] = (uint32_t)idx + 1;
+            }
+            cnt2 += num;
+        }
+
+        _indexKey = _numVerticesKey;
+        _hasIndex = _hasNumVerticesKey;
+        _indexSubdivision = _subdivision;
     }
+
+    *oidx  = DataPointer(_index, _indexCount * 4);
+    *ocurve = DataPointer((void*)pts, _pointCount * 4 * 3);
+
+    return indexUnchanged;
 }
 
-PolyMesh::PolyMesh(AbcGeom::IPolyMesh pmesh)
-    : abcrGeom(pmesh), _polymesh(pmesh), _hasRGB(false), _hasRGBA(false), _hasNormal(true), _hasUV(true),
-    _capacity(0), _vertexCount(0), _vertexSize(0)
+bool Curves::getTessellated(CurveTessellation::Mode mode, int sides, float widthScale, const V3f& view,
+    DataPointer* ogeom, DataPointer* oidx)
 {
-    _type = AlembicType::POLYMESH;
-    setMinMaxTime(_polymesh);
+    if (mode == CurveTessellation::LINES) return this->get(ogeom, oidx);
 
-    _samplingPtr = _polymesh.getSchema().getTimeSampling();
-    _numSamples = _polymesh.getSchema().getNumSamples();
+    const V3f* pts = this->evaluatePositions();
 
-    AbcGeom::IPolyMeshSchema mesh = _polymesh.getSchema();
-    auto geomParam = _polymesh.getSchema().getArbGeomParams();
+    const int nCurves = _curveCount;
+    const Alembic::Util::int32_t* nVertices = _numVertices;
+
+    // widths and normals are given per control point
+    const bool refined = nVertices == _refinedNumVertices.data();
+    const size_t nSource = _curveSample.getPositions()->size();
 
-    _topologyVariance = mesh.getTopologyVariance();
+    sides = std::max(sides, 3);
+    const int ring = mode == CurveTessellation::TUBE ? sides + 1 : 2;
+    const int stride = VertexPositionNormalTexture::VertexSize() / 4;
+
+    bool indexUnchanged = _hasTessIndex && _hasNumVerticesKey && _numVerticesKey == _tessIndexKey && _tessRing == ring
+        && _tessSubdivision == _subdivision;
+
+    if (!indexUnchanged)
+    {
+        _curveOffsets.resize(nCurves + 1);
+        _segmentOffsets.resize(nCurves + 1);
+        _curveOffsets[0] = _segmentOffsets[0] = 0;
+
+        for (int i = 0; i < nCurves; ++i)
+        {
+            _curveOffsets[i + 1] = _curveOffsets[i] + nVertices[i];
+            _segmentOffsets[i + 1] = _segmentOffsets[i] + std::max(nVertices[i] - 1, 0);
+        }
+
+        _tessIndex.resize(_segmentOffsets[nCurves] * (ring - 1) * 6);
+
+        #pragma omp parallel for
+        for (int i = 0; i < nCurves; ++i)
+        {
+            uint32_t* dst = _tessIndex.data() + _segmentOffsets[i] * (ring - 1) * 6;
+            const uint32_t base = (uint32_t)(_curveOffsets[i] * ring);
+
+            for (int j = 0; j < nVertices[i] - 1; ++j)
+            {
+                for (int k = 0; k < ring - 1; ++k)
+                {
+                    uint32_t a = base + j * ring + k;
+                    uint32_t c = a + ring;
+
+                    *dst++ = a; *dst++ = c; *dst++ = a + 1;
+                    *dst++ = a + 1; *dst++ = c; *dst++ = c + 1;
+                }
+            }
+        }
+
+        _tessIndexKey = _numVerticesKey;
+        _hasTessIndex = _hasNumVerticesKey;
+        _tessRing = ring;
+        _tessSubdivision = _subdivision;
+    }
+
+    _tessGeom.resize(_pointCount * ring * stride);
+
+    AbcGeom::ICurvesSchema curvSchema = _curves.getSchema();
+    ISampleSelector ss((index_t)_lastSampleIndex);
+
+    const float* widths = nullptr;
+    size_t nWidths = 0;
+    AbcGeom::IFloatGeomParam::Sample widthSample;
+    AbcGeom::IFloatGeomParam W = curvSchema.getWidthsParam();
+    if (W.valid() && W.getNumSamples() > 0)
+    {
+        widthSample = W.getExpandedValue(ss);
+        widths = widthSample.getVals()->get();
+        nWidths = widthSample.getVals()->size();
+    }
+
+    const N3f* norms = nullptr;
+    AbcGeom::IN3fGeomParam::Sample normSample;
+    AbcGeom::IN3fGeomParam N = curvSchema.getNormalsParam();
+    if (mode == CurveTessellation::RIBBON && N.valid() && N.getNumSamples() > 0)
+    {
+        normSample = N.getExpandedValue(ss);
+        if (normSample.getVals()->size() == nSource) norms = normSample.getVals()->get();
+    }
+
+    #pragma omp parallel for
+    for (int i = 0; i < nCurves; ++i)
+    {
+        const size_t begin = _curveOffsets[i];
+        const int num = nVertices[i];
+        float* dst = _tessGeom.data() + begin * ring * stride;
+
+        N3f frame;
+
+        for (int j = 0; j < num; ++j)
+        {
+            const V3f& p = pts[begin + j];
+
+            V3f tangent = pts[begin + std::min(j + 1, num - 1)] - pts[begin + std::max(j - 1, 0)];
+            tangent = tangent.length() > 0 ? tangent.normalize() : V3f(0, 1, 0);
+
+            float v = num > 1 ? (float)j / (num - 1) : 0;
+
+            // nearest control point of a refined curve
+            size_t source = begin + j;
+            if (refined)
+            {
+                const int n = (int)(_sourceOffsets[i + 1] - _sourceOffsets[i]);
+                source = _sourceOffsets[i] + (size_t)(v * (n - 1) + .5f);
+            }
+
+            float width = widthScale * .5f;
+            if (nWidths == nSource) width *= widths[source];
+            else if ((int)nWidths == nCurves) width *= widths[i];
+            else if (nWidths > 0) width *= widths[0];
+
+            if (mode == CurveTessellation::RIBBON)
+            {
+                V3f facing = norms != nullptr ? V3f(norms[source]) : view - p;
+                V3f side = tangent.cross(facing);
+                side = side.length() > 0 ? side.normalize() : perpendicular(tangent);
+                N3f n = side.cross(tangent).normalize();
+
+                copyTo(dst, p - side * width);
+                copyTo(dst, n);
+                copyTo(dst, V2f(0, v));
+
+                copyTo(dst, p + side * width);
+                copyTo(dst, n);
+                copyTo(dst, V2f(1, v));
+            }
+            else
+            {
+                // parallel transport the frame along the curve
+                if (j > 0) frame -= tangent * frame.dot(tangent);
+                frame = j > 0 && frame.length() > 0 ? frame.normalize() : perpendicular(tangent);
+                V3f binormal = tangent.cross(frame);
+
+                for (int k = 0; k < ring; ++k)
+                {
+                    float a = 2 * (float)M_PI * k / sides;
+                    N3f dir = frame * cos(a) + binormal * sin(a);
+
+                    copyTo(dst, p + dir * width);
+                    copyTo(dst, dir);
+                    copyTo(dst, V2f((float)k / sides, v));
+                }
+            }
+        }
+    }
+
+    *oidx = DataPointer(_tessIndex.data(), (int)_tessIndex.size() * 4);
+    *ogeom = DataPointer(_tessGeom.data(), (int)_tessGeom.size() * 4);
+
+    return indexUnchanged;
+}
+
+shared_ptr<PolyMeshInfo> PolyMeshInfo::read(AbcGeom::IPolyMesh& pmesh)
+{
+    auto info = make_shared<PolyMeshInfo>();
+
+    AbcGeom::IPolyMeshSchema& mesh = pmesh.getSchema();
+    auto geomParam = mesh.getArbGeomParams();
+
+    info->topologyVariance = mesh.getTopologyVariance();
 
     { // normal valid
         AbcGeom::IN3fGeomParam N = mesh.getNormalsParam();
-        if (!N.valid() || N.getNumSamples() <= 0 || N.getScope() == AbcGeom::kUnknownScope)
-            _hasNormal = false;
+        info->hasNormal = N.valid() && N.getNumSamples() > 0 && N.getScope() != AbcGeom::kUnknownScope;
     }
 
     { // uvs valid
         AbcGeom::IV2fGeomParam UV = mesh.getUVsParam();
-        if (!UV.valid() || UV.getNumSamples() <= 0 || UV.getScope() == AbcGeom::kUnknownScope)
-            _hasUV = false;
+        info->hasUV = UV.valid() && UV.getNumSamples() > 0 && UV.getScope() != AbcGeom::kUnknownScope;
     }
 
-    _vertexSize = VertexPositionNormalTexture::VertexSize();
-    _layout = VertexLayout::PosNormTex;
+    info->vertexSize = VertexPositionNormalTexture::VertexSize();
+    info->layout = VertexLayout::PosNormTex;
 
     if (geomParam.valid())
     {
@@ -434,40 +1305,83 @@ PolyMesh::PolyMesh(AbcGeom::IPolyMesh pmesh)
 
             if (AbcGeom::IC3fGeomParam::matches(head))
             {
-                _hasRGB = true;
-                _vertexSize = VertexPositionNormalColorTexture::VertexSize();
-                _layout = VertexLayout::PosNormColTex;
-                _rgbParam = AbcGeom::IC3fGeomParam(geomParam, head.getName());
+                info->hasRGB = true;
+                info->rgbName = head.getName();
             }
             else if (AbcGeom::IC4fGeomParam::matches(head))
             {
-                _hasRGBA = true;
-                _vertexSize = VertexPositionNormalColorTexture::VertexSize();
-                _layout = VertexLayout::PosNormColTex;
-                _rgbaParam = AbcGeom::IC4fGeomParam(geomParam, head.getName());
+                info->hasRGBA = true;
+                info->rgbaName = head.getName();
             }
         }
     }
 
-    if (_polymesh.getSchema().isConstant() &&
-        ((_hasRGB && _rgbParam.isConstant()) ||
-            (_hasRGBA && _rgbaParam.isConstant())))
+    if (info->hasRGB || info->hasRGBA)
     {
-        this->set(_minTime, _transform);
-        _constant = true;
+        info->vertexSize = VertexPositionNormalColorTexture::VertexSize();
+        info->layout = VertexLayout::PosNormColTex;
     }
 
-    size_t numSamples = _polymesh.getSchema().getNumSamples();
-    AbcGeom::IPolyMeshSchema::Sample sample;
-    size_t maxSize = 0;
-    for (index_t i = 0; i < numSamples; ++i)
+    const bool rgbConstant = info->hasRGB && AbcGeom::IC3fGeomParam(geomParam, info->rgbName).isConstant();
+    const bool rgbaConstant = info->hasRGBA && AbcGeom::IC4fGeomParam(geomParam, info->rgbaName).isConstant();
+
+    info->positionsConstant = mesh.getPositionsProperty().isConstant();
+    info->normalsConstant = info->hasNormal && mesh.getNormalsParam().isConstant();
+    info->uvsConstant = info->hasUV && mesh.getUVsParam().isConstant();
+    info->colorsConstant = rgbConstant || rgbaConstant;
+    info->constant = mesh.isConstant() && (rgbConstant || rgbaConstant);
+
+    return info;
+}
+
+shared_ptr<PolyMeshInfo> ObjectInfoCache::polyMesh(AbcGeom::IPolyMesh& pmesh)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    shared_ptr<PolyMeshInfo>& info = _polyMeshes[pmesh.getFullName()];
+    if (!info) info = PolyMeshInfo::read(pmesh);
+
+    return info;
+}
+
+PolyMesh::PolyMesh(AbcGeom::IPolyMesh pmesh, const shared_ptr<ObjectInfoCache>& infoCache)
+    : abcrGeom(pmesh, infoCache), _polymesh(pmesh), _hasRGB(false), _hasRGBA(false), _hasNormal(true), _hasUV(true),
+    _capacity(0), _vertexCount(0), _vertexSize(0)
+{
+    _type = AlembicType::POLYMESH;
+    setMinMaxTime(_polymesh);
+
+    _samplingPtr = _polymesh.getSchema().getTimeSampling();
+    _numSamples = _polymesh.getSchema().getNumSamples();
+
+    // schema flags are read by the first cursor of the archive, the stream is allocated by the first get
+    _info = infoCache ? infoCache->polyMesh(_polymesh) : PolyMeshInfo::read(_polymesh);
+    const PolyMeshInfo& info = *_info;
+
+    _topologyVariance = info.topologyVariance;
+
+    _hasNormal = info.hasNormal;
+    _hasUV = info.hasUV;
+    _hasRGB = info.hasRGB;
+    _hasRGBA = info.hasRGBA;
+
+    _vertexSize = info.vertexSize;
+    _layout = info.layout;
+
+    auto geomParam = _polymesh.getSchema().getArbGeomParams();
+    if (_hasRGB) _rgbParam = AbcGeom::IC3fGeomParam(geomParam, info.rgbName);
+    if (_hasRGBA) _rgbaParam = AbcGeom::IC4fGeomParam(geomParam, info.rgbaName);
+
+    _positionsConstant = info.positionsConstant;
+    _normalsConstant = info.normalsConstant;
+    _uvsConstant = info.uvsConstant;
+    _colorsConstant = info.colorsConstant;
+
+    if (info.constant)
     {
-        ISampleSelector ss(i);
-        _polymesh.getSchema().get(sample, ss);
-        maxSize = std::max<size_t>(maxSize, sample.getPositions()->size());
+        this->set(_minTime, _transform);
+        _constant = true;
     }
-
-    this->resize(maxSize * _vertexSize / 4 * 2);
 }
 
 void PolyMesh::resize(size_t size)
@@ -487,10 +1401,21 @@ void PolyMesh::set(chrono_t time, Imath::M44f& transform)
 {
     if (_constant) return;
 
+    // the assembled stream stays valid while the same samples are blended the same way
+    const index_t lastSample = _lastSampleIndex;
+    const chrono_t lastT = _t;
+    const float lastDt = _dt;
+    const bool lastInterpolate = _isInterpolate;
+
     AbcGeom::IPolyMeshSchema mesh = _polymesh.getSchema();
     AbcGeom::IN3fGeomParam N = mesh.getNormalsParam();
     AbcGeom::IV2fGeomParam UV = mesh.getUVsParam();
 
+    const bool extrapolate = _isExtrapolate && mesh.getVelocitiesProperty().valid();
+    if (extrapolate) _isInterpolate = false;
+
+    _dt = 0;
+
     if (_isInterpolate)
     {
         ISampleSelector ss0, ss1;
@@ -499,6 +1424,9 @@ void PolyMesh::set(chrono_t time, Imath::M44f& transform)
         mesh.get(_meshSample, ss0);
         mesh.get(_meshSample2, ss1);
 
+        _hasFaceKeys = mesh.getFaceIndicesProperty().getKey(_faceKey.indices, ss0) &&
+            mesh.getFaceCountsProperty().getKey(_faceKey.counts, ss0);
+
         if (_hasNormal)
         {
             _normSample  = N.getIndexedValue(ss0);
@@ -513,34 +1441,116 @@ void PolyMesh::set(chrono_t time, Imath::M44f& transform)
 
         if (_hasRGB)
         {
-            _rgbSample  = _rgbParam.getIndexedValue(ss0);
-            _rgbSample2 = _rgbParam.getIndexedValue(ss1);
+            _rgbSample  = _rgbParam.getIndexedValue(getPropertySelector(ss0, _rgbParam.getTimeSampling()));
+            _rgbSample2 = _rgbParam.getIndexedValue(getPropertySelector(ss1, _rgbParam.getTimeSampling()));
         }
         else if (_hasRGBA)
         {
-            _rgbaSample  = _rgbaParam.getIndexedValue(ss0);
-            _rgbaSample2 = _rgbaParam.getIndexedValue(ss1);
+            _rgbaSample  = _rgbaParam.getIndexedValue(getPropertySelector(ss0, _rgbaParam.getTimeSampling()));
+            _rgbaSample2 = _rgbaParam.getIndexedValue(getPropertySelector(ss1, _rgbaParam.getTimeSampling()));
         }
 
         _lastSampleIndex = ss0.getIndex(_samplingPtr, _numSamples);
     }
     else
     {
-        ISampleSelector ss(time, ISampleSelector::kNearIndex);
-
+        ISampleSelector ss = getSampleSelector(time, extrapolate ? ISampleSelector::kFloorIndex : ISampleSelector::kNearIndex);
 
         mesh.get(_meshSample, ss);
+        _hasFaceKeys = mesh.getFaceIndicesProperty().getKey(_faceKey.indices, ss) &&
+            mesh.getFaceCountsProperty().getKey(_faceKey.counts, ss);
+
         if (_hasNormal) _normSample = N.getIndexedValue(ss);
         if (_hasUV) _uvSample = UV.getIndexedValue(ss);
 
-        if (_hasRGB) _rgbSample = _rgbParam.getIndexedValue(ss);
-        else if (_hasRGBA) _rgbaSample = _rgbaParam.getIndexedValue(ss);
+        if (_hasRGB) _rgbSample = _rgbParam.getIndexedValue(getPropertySelector(ss, _rgbParam.getTimeSampling()));
+        else if (_hasRGBA) _rgbaSample = _rgbaParam.getIndexedValue(getPropertySelector(ss, _rgbaParam.getTimeSampling()));
 
         _lastSampleIndex = ss.getIndex(_samplingPtr, _numSamples);
+
+        if (extrapolate) _dt = (float)(time - _samplingPtr->getSampleTime(_lastSampleIndex));
     }
+
+    if (_lastSampleIndex != lastSample || _t != lastT || _dt != lastDt || _isInterpolate != lastInterpolate)
+        _prepared = false;
+}
+
+void PolyMesh::prepare()
+{
+    // build whichever stream the mesh is read with
+    const bool split = this->isSplit();
+    if (_prepared && _preparedSplit == split) return;
+
+    _prepared = false;
+    _preparedStream = this->assemble(&_preparedSize, split);
+    _preparedSplit = split;
+    _preparedServed = false;
+    _prepared = true;
+}
+
+float* PolyMesh::take(int* size, bool split)
+{
+    if (!_prepared || _preparedSplit != split)
+    {
+        _preparedStream = this->assemble(&_preparedSize, split);
+        _preparedSplit = split;
+        _prepared = true;
+    }
+    else if (_preparedServed)
+    {
+        // handed out before and nothing changed since
+        _dirtyRanges.clear();
+        _staticWritten = false;
+    }
+
+    _preparedServed = true;
+
+    *size = _preparedSize;
+    return _preparedStream;
+}
+
+void PolyMesh::copySettings(const abcrGeom& source)
+{
+    const PolyMesh& o = static_cast<const PolyMesh&>(source);
+
+    if (o._compact != _compact) setCompact(o._compact);
+    if (o._smoothNormals != _smoothNormals || o._hardEdgeAngle != _hardEdgeAngle) setSmoothNormals(o._smoothNormals, o._hardEdgeAngle);
+    if (o._splitStreams != _splitStreams) setSplitStreams(o._splitStreams);
+    if (o._tangents != _tangents) setTangents(o._tangents);
+    if (o._trackDirty != _trackDirty) setDirtyTracking(o._trackDirty);
+}
+
+void PolyMesh::copyHistory(const abcrGeom& source)
+{
+    const PolyMesh& o = static_cast<const PolyMesh&>(source);
+
+    // the static stream is shown as long as its topology and attributes match the one of the front
+    if (!o._staticValid || !_staticValid || o._staticMask != _staticMask || o._topology != _topology)
+        _staticValid = false;
+
+    if (_trackDirty) _chunkHashes = o._chunkHashes;
+
+    // the next stream reports its changes against the front
+    _prepared = false;
 }
 
 float* PolyMesh::get(int* size)
+{
+    return this->take(size, false);
+}
+
+float* PolyMesh::getSplit(int* size)
+{
+    if (!this->isSplit())
+    {
+        *size = 0;
+        return nullptr;
+    }
+
+    return this->take(size, true);
+}
+
+float* PolyMesh::assemble(int* size, bool split)
 {
     //sample some property
     P3fArraySamplePtr m_points, m_points2;
@@ -595,6 +1605,7 @@ float* PolyMesh::get(int* size)
         {
             _hasRGB = false; // invalid value
             _layout = PosNormTex;
+            _vertexSize = VertexPositionNormalTexture::VertexSize();
         }
     }
 
@@ -611,6 +1622,7 @@ float* PolyMesh::get(int* size)
         {
             _hasRGBA = false; // invalid value
             _layout = PosNormTex;
+            _vertexSize = VertexPositionNormalTexture::VertexSize();
         }
     }
 
@@ -631,78 +1643,202 @@ float* PolyMesh::get(int* size)
     }
 
     using tri = Imath::Vec3<uint32_t>;
-    using triArray = std::vector<tri>;
-    triArray m_triangles;
-    std::vector<int32_t> inds;
 
+    if (!this->updateTopology(m_indices, m_faceCounts))
     {
-        size_t fBegin = 0;
-        size_t fEnd = 0;
-        for (size_t face = 0; face < nFace; ++face)
+        *size = 0;
+        return nullptr;
+    }
+
+    const vector<tri>& m_triangles = _topology->triangles;
+
+    size_t sizeInBytes = m_triangles.size() * 3 * streamVertexSize();
+    _vertexCount = m_triangles.size() * 3;
+    if (!split) this->resize(sizeInBytes / 4);
+
+    {
+        const V3f *points, *points2 = nullptr;
+        points = m_points->get();
+
+        V3fArraySamplePtr m_velocities = _meshSample.getVelocities();
+        if (_dt != 0 && m_velocities && m_velocities->size() == nPts)
         {
-            fBegin = fEnd;
-            size_t count = (*m_faceCounts)[face];
-            fEnd = fBegin + count;
+            const V3f* vel = m_velocities->get();
+            const float dt = _dt;
+
+            _extrapolated.resize(nPts);
+
+            #pragma omp parallel for
+            for (int i = 0; i < (int)nPts; ++i)
+                _extrapolated[i] = points[i] + vel[i] * dt;
 
-            if (fEnd > nInds || fEnd < fBegin)
+            points = _extrapolated.data();
+        }
+
+        const N3f *norms, *norms2 = nullptr;
+        norms = _hasNormal ? m_norms->get() : nullptr;
+
+        const V2f *uvs, *uvs2 = nullptr;
+        uvs = _hasUV ? m_uvs->get() : nullptr;
+
+        if (_isInterpolate)
+        {
+            points2 = m_points2->get();
+            norms2 = _hasNormal ? m_norms2->get() : nullptr;
+            uvs2 = _hasUV ? m_uvs2->get() : nullptr;
+        }
+
+        const int32_t* indices = m_indices->get();
+
+        const int32_t* normIndices = nullptr;
+        if (_hasNormal)
+        {
+            if (normalIndexType == 0) normIndices = (int32_t*)_normSample.getIndices()->get();
+            else if (normalIndexType == 1) normIndices = indices;
+        }
+
+        const int32_t* uvIndices = nullptr;
+        if (_hasUV)
+        {
+            if (uvIndexType == 0) uvIndices = (int32_t*)_uvSample.getIndices()->get();
+            else if (uvIndexType == 1) uvIndices = indices;
+        }
+
+        const N3f* smoothNormals = nullptr;
+        if (!_hasNormal && _smoothNormals)
+        {
+            const V3f* blended = points;
+            if (_isInterpolate)
             {
-                *size = 0;
-                return nullptr;
+                const float t = (float)_t;
+                _blendedPoints.resize(nPts);
+
+                #pragma omp parallel for
+                for (int i = 0; i < (int)nPts; ++i)
+                    _blendedPoints[i] = points[i] + (points2[i] - points[i]) * t;
+
+                blended = _blendedPoints.data();
             }
 
-            if (count >= 3)
+            this->computeSmoothNormals(blended, indices, nPts);
+            smoothNormals = _cornerNormals.data();
+        }
+
+        if (split)
+        {
+            const int dynamicMask = this->getStreamMask(true);
+            const int staticMask = this->getStreamMask(false);
+            const bool writeStatic = !_staticValid || staticMask != _staticMask;
+
+            const size_t dynamicStride = VertexStream::floatCount(dynamicMask);
+            const size_t staticStride = VertexStream::floatCount(staticMask);
+
+            _dynamicStream.resize(_vertexCount * dynamicStride);
+            if (writeStatic) _staticStream.resize(_vertexCount * staticStride);
+
+            const C3f* rgb = _hasRGB ? _rgbSample.getVals()->get() : nullptr;
+            const C4f* rgba = _hasRGBA ? _rgbaSample.getVals()->get() : nullptr;
+            const C3f* rgb2 = _hasRGB && _isInterpolate ? _rgbSample2.getVals()->get() : nullptr;
+            const C4f* rgba2 = _hasRGBA && _isInterpolate ? _rgbaSample2.getVals()->get() : nullptr;
+
+            const size_t colorCount = _hasRGB ? _rgbSample.getVals()->size() : _hasRGBA ? _rgbaSample.getVals()->size() : 0;
+            const bool isIndexedColor = colorCount == nPts;
+
+            const float t = _isInterpolate ? (float)_t : 0;
+
+            #pragma omp parallel for
+            for (int j = 0; j < (int)m_triangles.size(); ++j)
             {
-                m_triangles.push_back(tri((uint32_t)fBegin + 0,
-                    (uint32_t)fBegin + 1,
-                    (uint32_t)fBegin + 2));
-                for (size_t c = 3; c < count; ++c)
+                const tri& tr = m_triangles[j];
+
+                V3f p[3];
+                for (int k = 0; k < 3; ++k)
                 {
-                    m_triangles.push_back(tri((uint32_t)fBegin + 0,
-                        (uint32_t)fBegin + c - 1,
-                        (uint32_t)fBegin + c));
+                    p[k] = points[indices[tr[k]]];
+                    if (points2) p[k] += (points2[indices[tr[k]]] - p[k]) * t;
                 }
-            }
-        }
-    }
 
-    size_t sizeInBytes = m_triangles.size() * 3 * _vertexSize;
-    this->resize(sizeInBytes / 4);
-    _vertexCount = m_triangles.size() * 3;
+                const N3f faceNormal = !_hasNormal && !smoothNormals ? computeFaceNormal(p[0], p[1], p[2]) : N3f(0);
+
+                for (int k = 0; k < 3; ++k)
+                {
+                    const uint32_t c = tr[k];
+                    const size_t v = (size_t)j * 3 + k;
+
+                    float* d = _dynamicStream.data() + v * dynamicStride;
+                    float* st = writeStatic ? _staticStream.data() + v * staticStride : nullptr;
+
+                    // animated attributes go to the dynamic stream, the rest only when the static one is rewritten
+                    auto target = [&](int attribute) -> float** { return (dynamicMask & attribute) ? &d : (st ? &st : nullptr); };
+
+                    if (float** o = target(VertexStream::POSITION)) copyTo(*o, p[k]);
+
+                    if (float** o = target(VertexStream::NORMAL))
+                    {
+                        N3f n = faceNormal;
+                        if (_hasNormal)
+                        {
+                            const int32_t idx = normalIndexType < 2 ? normIndices[c] : (int32_t)c;
+                            n = norms[idx];
+                            if (norms2) n += (norms2[idx] - n) * t;
+                        }
+                        else if (smoothNormals)
+                        {
+                            n = smoothNormals[v];
+                        }
+
+                        copyTo(*o, n);
+                    }
+
+                    if (float** o = (rgb || rgba) ? target(VertexStream::COLOR) : nullptr)
+                    {
+                        const int32_t idx = isIndexedColor ? indices[c] : (int32_t)c;
+                        C4f col;
+                        if (rgb)
+                        {
+                            C3f c3 = rgb[idx];
+                            if (rgb2) c3 += (rgb2[idx] - c3) * t;
+                            col = C4f(c3.x, c3.y, c3.z, 1.0f);
+                        }
+                        else
+                        {
+                            col = rgba[idx];
+                            if (rgba2) col += (rgba2[idx] - col) * t;
+                        }
 
-    {
-        const V3f *points, *points2 = nullptr;
-        points = m_points->get();
+                        copyTo(*o, col);
+                    }
 
-        const N3f *norms, *norms2 = nullptr;
-        norms = _hasNormal ? m_norms->get() : nullptr;
+                    if (float** o = target(VertexStream::TEXCOORD))
+                    {
+                        V2f uv(0);
+                        if (_hasUV)
+                        {
+                            const int32_t idx = uvIndexType < 2 ? uvIndices[c] : (int32_t)c;
+                            uv = uvs[idx];
+                            if (uvs2) uv += (uvs2[idx] - uv) * t;
+                        }
 
-        const V2f *uvs, *uvs2 = nullptr;
-        uvs = _hasUV ? m_uvs->get() : nullptr;
+                        copyTo(*o, uv);
+                    }
+                }
+            }
 
-        if (_isInterpolate)
-        {
-            points2 = m_points2->get();
-            norms2 = _hasNormal ? m_norms2->get() : nullptr;
-            uvs2 = _hasUV ? m_uvs2->get() : nullptr;
-        }
+            _staticValid = true;
+            _staticMask = staticMask;
+            _staticWritten = writeStatic;
 
-        const int32_t* indices = m_indices->get();
+            sizeInBytes = _dynamicStream.size() * sizeof(float);
+            if (_trackDirty) this->updateDirtyRanges(_dynamicStream.data(), sizeInBytes);
 
-        const int32_t* normIndices = nullptr;
-        if (_hasNormal)
-        {
-            if (normalIndexType == 0) normIndices = (int32_t*)_normSample.getIndices()->get();
-            else if (normalIndexType == 1) normIndices = indices;
+            *size = (int)sizeInBytes;
+            return _dynamicStream.data();
         }
 
-        const int32_t* uvIndices = nullptr;
-        if (_hasUV)
-        {
-            if (uvIndexType == 0) uvIndices = (int32_t*)_uvSample.getIndices()->get();
-            else if (uvIndexType == 1) uvIndices = indices;
-        }
+        const size_t floatStride = streamVertexSize() / 4;
 
-        float* stream = _geom;
+        // filled by computeTangents once the stream is written
+        const size_t tangentFloats = hasTangents() ? 4 : 0;
 
         if (_hasRGB)
         {
@@ -717,9 +1853,11 @@ float* PolyMesh::get(int* size)
                 cols2 = _rgbSample2.getVals()->get();
             }
 
-            for (size_t j = 0; j < m_triangles.size(); ++j)
+            #pragma omp parallel for
+            for (int j = 0; j < (int)m_triangles.size(); ++j)
             {
-                tri& t = m_triangles[j];
+                float* stream = _geom + (size_t)j * 3 * floatStride;
+                const tri& t = m_triangles[j];
 
                 V3f v0 = points[indices[t[0]]];
                 C3f col0 = isIndexedColor ? cols[indices[t[0]]] : cols[t[0]];
@@ -754,8 +1892,16 @@ float* PolyMesh::get(int* size)
                 N3f n0, n1, n2;
                 if (!_hasNormal)
                 {
-                    N3f faceNormal = _hasNormal ? N3f(0) : computeFaceNormal(v0, v1, v2);
-                    n0 = n1 = n2 = faceNormal;
+                    if (smoothNormals)
+                    {
+                        n0 = smoothNormals[j * 3 + 0];
+                        n1 = smoothNormals[j * 3 + 1];
+                        n2 = smoothNormals[j * 3 + 2];
+                    }
+                    else
+                    {
+                        n0 = n1 = n2 = computeFaceNormal(v0, v1, v2);
+                    }
                 }
                 else
                 {
@@ -802,8 +1948,7 @@ float* PolyMesh::get(int* size)
 
                     if (!_hasNormal)
                     {
-                        const N3f faceNormal2 = _hasNormal ? N3f(0) : computeFaceNormal(v0, v1, v2);
-                        n0 = n1 = n2 = faceNormal2;
+                        if (!smoothNormals) n0 = n1 = n2 = computeFaceNormal(v0, v1, v2);
                     }
                     else
                     {
@@ -825,16 +1970,19 @@ float* PolyMesh::get(int* size)
                 copyTo(stream, v0);
                 copyTo(stream, n0);
                 copyTo(stream, col0);
+                stream += tangentFloats;
                 copyTo(stream, uv0);
 
                 copyTo(stream, v1);
                 copyTo(stream, n1);
                 copyTo(stream, col1);
+                stream += tangentFloats;
                 copyTo(stream, uv1);
 
                 copyTo(stream, v2);
                 copyTo(stream, n2);
                 copyTo(stream, col2);
+                stream += tangentFloats;
                 copyTo(stream, uv2);
             }
         }
@@ -848,9 +1996,11 @@ float* PolyMesh::get(int* size)
 
             const C4f* cols2 = nullptr;
             if(_isInterpolate) cols2 = _rgbaSample2.getVals()->get();
-            for (size_t j = 0; j < m_triangles.size(); ++j)
+            #pragma omp parallel for
+            for (int j = 0; j < (int)m_triangles.size(); ++j)
             {
-                tri& t = m_triangles[j];
+                float* stream = _geom + (size_t)j * 3 * floatStride;
+                const tri& t = m_triangles[j];
 
                 V3f v0 = points[indices[t[0]]];
                 C4f col0 = isIndexedColor ? cols[indices[t[0]]] : cols[t[0]];
@@ -885,8 +2035,16 @@ float* PolyMesh::get(int* size)
                 N3f n0, n1, n2;
                 if (!_hasNormal)
                 {
-                    N3f faceNormal = _hasNormal ? N3f(0) : computeFaceNormal(v0, v1, v2);
-                    n0 = n1 = n2 = faceNormal;
+                    if (smoothNormals)
+                    {
+                        n0 = smoothNormals[j * 3 + 0];
+                        n1 = smoothNormals[j * 3 + 1];
+                        n2 = smoothNormals[j * 3 + 2];
+                    }
+                    else
+                    {
+                        n0 = n1 = n2 = computeFaceNormal(v0, v1, v2);
+                    }
                 }
                 else
                 {
@@ -933,8 +2091,7 @@ float* PolyMesh::get(int* size)
 
                     if (!_hasNormal)
                     {
-                        const N3f faceNormal2 = _hasNormal ? N3f(0) : computeFaceNormal(v0, v1, v2);
-                        n0 = n1 = n2 = faceNormal2;
+                        if (!smoothNormals) n0 = n1 = n2 = computeFaceNormal(v0, v1, v2);
                     }
                     else
                     {
@@ -956,24 +2113,29 @@ float* PolyMesh::get(int* size)
                 copyTo(stream, v0);
                 copyTo(stream, n0);
                 copyTo(stream, col0);
+                stream += tangentFloats;
                 copyTo(stream, uv0);
 
                 copyTo(stream, v1);
                 copyTo(stream, n1);
                 copyTo(stream, col1);
+                stream += tangentFloats;
                 copyTo(stream, uv1);
 
                 copyTo(stream, v2);
                 copyTo(stream, n2);
                 copyTo(stream, col2);
+                stream += tangentFloats;
                 copyTo(stream, uv2);
             }
         }
         else
         {
-            for (size_t j = 0; j < m_triangles.size(); ++j)
+            #pragma omp parallel for
+            for (int j = 0; j < (int)m_triangles.size(); ++j)
             {
-                tri& t = m_triangles[j];
+                float* stream = _geom + (size_t)j * 3 * floatStride;
+                const tri& t = m_triangles[j];
 
                 V3f v0 = points[indices[t[0]]];
                 V3f v1 = points[indices[t[1]]];
@@ -1003,8 +2165,16 @@ float* PolyMesh::get(int* size)
                 N3f n0, n1, n2;
                 if (!_hasNormal)
                 {
-                    N3f faceNormal = _hasNormal ? N3f(0) : computeFaceNormal(v0, v1, v2);
-                    n0 = n1 = n2 = faceNormal;
+                    if (smoothNormals)
+                    {
+                        n0 = smoothNormals[j * 3 + 0];
+                        n1 = smoothNormals[j * 3 + 1];
+                        n2 = smoothNormals[j * 3 + 2];
+                    }
+                    else
+                    {
+                        n0 = n1 = n2 = computeFaceNormal(v0, v1, v2);
+                    }
                 }
                 else
                 {
@@ -1046,8 +2216,7 @@ float* PolyMesh::get(int* size)
 
                     if (!_hasNormal)
                     {
-                        const N3f faceNormal2 = _hasNormal ? N3f(0) : computeFaceNormal(v0, v1, v2);
-                        n0 = n1 = n2 = faceNormal2;
+                        if (!smoothNormals) n0 = n1 = n2 = computeFaceNormal(v0, v1, v2);
                     }
                     else
                     {
@@ -1068,21 +2237,536 @@ float* PolyMesh::get(int* size)
 
                 copyTo(stream, v0);
                 copyTo(stream, n0);
+                stream += tangentFloats;
                 copyTo(stream, uv0);
 
                 copyTo(stream, v1);
                 copyTo(stream, n1);
+                stream += tangentFloats;
                 copyTo(stream, uv1);
 
                 copyTo(stream, v2);
                 copyTo(stream, n2);
+                stream += tangentFloats;
                 copyTo(stream, uv2);
             }
         }
     }
 
+    if (hasTangents()) this->computeTangents(m_indices->get(), nPts);
+
+    float* result = _geom;
+
+    if (_compact)
+    {
+        sizeInBytes = this->pack();
+        result = reinterpret_cast<float*>(_packed.data());
+    }
+
+    if (_trackDirty) this->updateDirtyRanges(result, sizeInBytes);
+
     *size = sizeInBytes;
-    return _geom;
+    return result;
+}
+
+bool PolyMesh::updateTopology(const Int32ArraySamplePtr& faceIndices, const Int32ArraySamplePtr& faceCounts)
+{
+    const bool hasKeys = _hasFaceKeys && this->readFaceSetKeys(_faceKey.faceSets);
+    if (_hasTopology && hasKeys && _faceKey == _topologyKey)
+        return true;
+
+    _hasTopology = false;
+    _staticValid = false;
+
+    if (hasKeys && _topologyCache)
+    {
+        _topology = _topologyCache->find(getFullName(), _faceKey);
+        if (_topology)
+        {
+            _hasTopology = true;
+            _topologyKey = _faceKey;
+            return true;
+        }
+    }
+
+    _topology = make_shared<MeshTopology>();
+    auto& triangles = _topology->triangles;
+    auto& triangleFaces = _topology->triangleFaces;
+
+    const size_t nInds = faceIndices->size();
+    const size_t nFace = faceCounts->size();
+
+    size_t fBegin = 0;
+    size_t fEnd = 0;
+    for (size_t face = 0; face < nFace; ++face)
+    {
+        fBegin = fEnd;
+        size_t count = (*faceCounts)[face];
+        fEnd = fBegin + count;
+
+        if (fEnd > nInds || fEnd < fBegin)
+        {
+            triangles.clear();
+            return false;
+        }
+
+        for (size_t c = 2; c < count; ++c)
+        {
+            triangles.emplace_back((uint32_t)fBegin, (uint32_t)(fBegin + c - 1), (uint32_t)(fBegin + c));
+            triangleFaces.push_back((int)face);
+        }
+    }
+
+    this->sortByFaceSets(*_topology, nFace);
+
+    _hasTopology = hasKeys;
+    _topologyKey = _faceKey;
+
+    if (_hasTopology && _topologyCache)
+        _topologyCache->insert(getFullName(), _faceKey, _topology);
+
+    return true;
+}
+
+const vector<FaceSetRange>& PolyMesh::getFaceSets() const
+{
+    static const vector<FaceSetRange> empty;
+    return _topology ? _topology->faceSets : empty;
+}
+
+bool PolyMesh::getStreamPoints(vector<int>& o)
+{
+    Int32ArraySamplePtr faceIndices = _meshSample.getFaceIndices();
+    Int32ArraySamplePtr faceCounts = _meshSample.getFaceCounts();
+    if (!faceIndices || !faceCounts || !this->updateTopology(faceIndices, faceCounts)) return false;
+
+    const auto& triangles = _topology->triangles;
+    const int32_t* indices = faceIndices->get();
+
+    o.resize(triangles.size() * 3);
+
+    #pragma omp parallel for
+    for (int j = 0; j < (int)triangles.size(); ++j)
+        for (int k = 0; k < 3; ++k)
+            o[(size_t)j * 3 + k] = indices[triangles[j][k]];
+
+    return true;
+}
+
+shared_ptr<MeshTopology> TopologyCache::find(const string& name, const TopologyKey& key)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    auto it = _entries.find(make_pair(name, key));
+    return it != _entries.end() ? it->second.lock() : nullptr;
+}
+
+void TopologyCache::insert(const string& name, const TopologyKey& key, const shared_ptr<MeshTopology>& topology)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    // drop the topologies no cursor shows anymore
+    for (auto it = _entries.begin(); it != _entries.end();)
+    {
+        if (it->second.expired()) it = _entries.erase(it);
+        else ++it;
+    }
+
+    _entries[make_pair(name, key)] = topology;
+}
+
+int PolyMesh::getStreamMask(bool dynamic) const
+{
+    const bool hasColor = _hasRGB || _hasRGBA;
+    const int present = VertexStream::POSITION | VertexStream::NORMAL | VertexStream::TEXCOORD | (hasColor ? VertexStream::COLOR : 0);
+
+    // generated normals follow the positions
+    int animated = 0;
+    if (!_positionsConstant) animated |= VertexStream::POSITION;
+    if (_hasNormal ? !_normalsConstant : !_positionsConstant) animated |= VertexStream::NORMAL;
+    if (_hasUV && !_uvsConstant) animated |= VertexStream::TEXCOORD;
+    if (hasColor && !_colorsConstant) animated |= VertexStream::COLOR;
+
+    return dynamic ? animated : present & ~animated;
+}
+
+const float* PolyMesh::getStaticStream(int* size) const
+{
+    *size = (int)(_staticStream.size() * sizeof(float));
+    return _staticStream.data();
+}
+
+bool PolyMesh::readFaceSetKeys(vector<AbcA::ArraySampleKey>& keys)
+{
+    AbcGeom::IPolyMeshSchema& mesh = _polymesh.getSchema();
+
+    vector<string> names;
+    mesh.getFaceSetNames(names);
+
+    // same sample as sortByFaceSets reads
+    ISampleSelector ss(_samplingPtr->getSampleTime(_lastSampleIndex));
+
+    keys.assign(names.size(), AbcA::ArraySampleKey());
+    for (size_t g = 0; g < names.size(); ++g)
+    {
+        AbcGeom::IFaceSet faceSetObj = mesh.getFaceSet(names[g]);
+        if (!faceSetObj.valid()) continue;
+
+        if (!faceSetObj.getSchema().getFacesProperty().getKey(keys[g], ss)) return false;
+    }
+
+    return true;
+}
+
+void PolyMesh::sortByFaceSets(MeshTopology& topology, size_t nFace)
+{
+    AbcGeom::IPolyMeshSchema& mesh = _polymesh.getSchema();
+
+    vector<string> names;
+    mesh.getFaceSetNames(names);
+    if (names.empty()) return;
+
+    const int nSets = (int)names.size();
+    ISampleSelector ss(_samplingPtr->getSampleTime(_lastSampleIndex));
+
+    // faces in several sets go to the first one, the rest to a trailing unnamed range
+    vector<int> faceSet(nFace, nSets);
+    for (int g = nSets - 1; g >= 0; --g)
+    {
+        AbcGeom::IFaceSet faceSetObj = mesh.getFaceSet(names[g]);
+        if (!faceSetObj.valid()) continue;
+
+        Int32ArraySamplePtr faces = faceSetObj.getSchema().getValue(ss).getFaces();
+        if (!faces) continue;
+
+        for (size_t i = 0; i < faces->size(); ++i)
+        {
+            const int f = (*faces)[i];
+            if (f >= 0 && f < (int)nFace) faceSet[f] = g;
+        }
+    }
+
+    // stable counting sort of the triangles by set
+    vector<int> offsets(nSets + 2, 0);
+    for (int face : topology.triangleFaces) ++offsets[faceSet[face] + 1];
+    for (int g = 0; g <= nSets; ++g) offsets[g + 1] += offsets[g];
+
+    for (int g = 0; g <= nSets; ++g)
+    {
+        const int count = offsets[g + 1] - offsets[g];
+        if (count > 0) topology.faceSets.push_back(FaceSetRange(g < nSets ? names[g] : "", offsets[g] * 3, count * 3));
+    }
+
+    vector<Imath::Vec3<uint32_t>> sorted(topology.triangles.size());
+    vector<int> sortedFaces(topology.triangles.size());
+    for (size_t j = 0; j < topology.triangles.size(); ++j)
+    {
+        const int k = offsets[faceSet[topology.triangleFaces[j]]]++;
+        sorted[k] = topology.triangles[j];
+        sortedFaces[k] = topology.triangleFaces[j];
+    }
+
+    topology.triangles.swap(sorted);
+    topology.triangleFaces.swap(sortedFaces);
+}
+
+shared_ptr<const PointCorners> PolyMesh::updateAdjacency(const int32_t* indices, size_t nPts)
+{
+    MeshTopology& topology = *_topology;
+
+    // cursors sharing the topology may get here together
+    std::lock_guard<std::mutex> lock(topology.adjacencyLock);
+
+    // points past the last index have no corners, so a table built for more points serves fewer
+    if (topology.adjacency && topology.adjacency->start.size() >= nPts + 1) return topology.adjacency;
+
+    const auto& triangles = topology.triangles;
+    const int nCorners = (int)triangles.size() * 3;
+
+    // (point, corner) pairs sorted by point give the corners around every point
+    vector<pair<int, int>> pairs(nCorners);
+
+    #pragma omp parallel for
+    for (int c = 0; c < nCorners; ++c)
+        pairs[c] = make_pair((int)indices[triangles[c / 3][c % 3]], c);
+
+    parallelSort(pairs);
+
+    auto adjacency = make_shared<PointCorners>();
+
+    vector<int>& corners = adjacency->corners;
+    corners.resize(nCorners);
+
+    #pragma omp parallel for
+    for (int c = 0; c < nCorners; ++c)
+        corners[c] = pairs[c].second;
+
+    vector<int>& cornerStart = adjacency->start;
+    cornerStart.resize(nPts + 1);
+
+    #pragma omp parallel for
+    for (int p = 0; p <= (int)nPts; ++p)
+        cornerStart[p] = (int)(std::lower_bound(pairs.begin(), pairs.end(), make_pair(p, -1)) - pairs.begin());
+
+    topology.adjacency = adjacency;
+    return adjacency;
+}
+
+void PolyMesh::computeSmoothNormals(const V3f* points, const int32_t* indices, size_t nPts)
+{
+    // held until the end so another cursor replacing the corners can't pull them away
+    const shared_ptr<const PointCorners> adjacency = this->updateAdjacency(indices, nPts);
+
+    const auto& triangles = _topology->triangles;
+    const vector<int>& cornerStart = adjacency->start;
+    const vector<int>& corners = adjacency->corners;
+
+    const int nTris = (int)triangles.size();
+
+    _faceNormals.resize(nTris);
+    _cornerWeights.resize(nTris * 3);
+    _cornerNormals.resize(nTris * 3);
+
+    // face normal and the angle of every corner as its weight
+    #pragma omp parallel for
+    for (int j = 0; j < nTris; ++j)
+    {
+        const auto& t = triangles[j];
+        const V3f p[3] = { points[indices[t[0]]], points[indices[t[1]]], points[indices[t[2]]] };
+
+        _faceNormals[j] = computeFaceNormal(p[0], p[1], p[2]);
+
+        for (int k = 0; k < 3; ++k)
+        {
+            const V3f e0 = (p[(k + 1) % 3] - p[k]).normalized();
+            const V3f e1 = (p[(k + 2) % 3] - p[k]).normalized();
+            _cornerWeights[j * 3 + k] = acosf(std::max(-1.0f, std::min(1.0f, e0.dot(e1))));
+        }
+    }
+
+    const bool hardEdges = _hardEdgeAngle < 180;
+    const float cosThreshold = cosf(_hardEdgeAngle * (float)M_PI / 180);
+
+    #pragma omp parallel
+    {
+        vector<N3f> seeds, sums;
+        vector<int> clusters;
+
+        #pragma omp for
+        for (int i = 0; i < (int)nPts; ++i)
+        {
+            const int begin = cornerStart[i];
+            const int end = cornerStart[i + 1];
+
+            if (!hardEdges)
+            {
+                N3f n(0);
+                for (int c = begin; c < end; ++c)
+                    n += _faceNormals[corners[c] / 3] * _cornerWeights[corners[c]];
+
+                n.normalize();
+                for (int c = begin; c < end; ++c) _cornerNormals[corners[c]] = n;
+                continue;
+            }
+
+            // group the corners by the first face of a cluster within the angle,
+            // a point has few clusters so this stays linear in its corners
+            seeds.clear();
+            sums.clear();
+            clusters.resize(end - begin);
+
+            for (int a = begin; a < end; ++a)
+            {
+                const N3f& f = _faceNormals[corners[a] / 3];
+
+                int k = 0;
+                while (k < (int)seeds.size() && seeds[k].dot(f) < cosThreshold) ++k;
+
+                if (k == (int)seeds.size())
+                {
+                    seeds.push_back(f);
+                    sums.push_back(N3f(0));
+                }
+
+                sums[k] += f * _cornerWeights[corners[a]];
+                clusters[a - begin] = k;
+            }
+
+            for (int a = begin; a < end; ++a)
+                _cornerNormals[corners[a]] = sums[clusters[a - begin]].normalized();
+        }
+    }
+}
+
+void PolyMesh::computeTangents(const int32_t* indices, size_t nPts)
+{
+    // held until the end so another cursor replacing the corners can't pull them away
+    const shared_ptr<const PointCorners> adjacency = this->updateAdjacency(indices, nPts);
+
+    const auto& triangles = _topology->triangles;
+    const vector<int>& cornerStart = adjacency->start;
+    const vector<int>& corners = adjacency->corners;
+
+    const int nTris = (int)triangles.size();
+    const size_t stride = streamVertexSize() / 4;
+    const size_t tangentOffset = _layout == PosNormColTex ? 10 : 6;
+
+    float* stream = _geom;
+
+    _faceTangents.resize(nTris);
+    _faceBitangents.resize(nTris);
+
+    // per face frame from the written positions and uvs, so blending and extrapolation are already applied
+    #pragma omp parallel for
+    for (int j = 0; j < nTris; ++j)
+    {
+        V3f p[3];
+        V2f uv[3];
+        for (int k = 0; k < 3; ++k)
+        {
+            const float* v = stream + (j * 3 + k) * stride;
+            p[k] = V3f(v[0], v[1], v[2]);
+            uv[k] = V2f(v[stride - 2], v[stride - 1]);
+        }
+
+        computeMeshTangent(p, uv, _faceTangents[j], _faceBitangents[j]);
+    }
+
+    // corners of a point only share a tangent when they share the uv too, so seams keep their own frames.
+    // a point has few (uv, handedness) keys, so grouping stays linear in its corners
+    struct TangentKey
+    {
+        V2f uv;
+        bool handed;
+        V3f t, b;
+    };
+
+    #pragma omp parallel
+    {
+        vector<TangentKey> keys;
+        vector<int> cornerKeys;
+
+        #pragma omp for
+        for (int i = 0; i < (int)nPts; ++i)
+        {
+            const int begin = cornerStart[i];
+            const int end = cornerStart[i + 1];
+
+            keys.clear();
+            cornerKeys.resize(end - begin);
+
+            for (int a = begin; a < end; ++a)
+            {
+                const float* v = stream + (size_t)corners[a] * stride;
+                const V3f n(v[3], v[4], v[5]);
+                const V2f uv(v[stride - 2], v[stride - 1]);
+
+                // mirrored uvs get their own tangent
+                const int f = corners[a] / 3;
+                const bool handed = _faceTangents[f].cross(_faceBitangents[f]).dot(n) >= 0;
+
+                int k = 0;
+                while (k < (int)keys.size() && (keys[k].uv != uv || keys[k].handed != handed)) ++k;
+
+                if (k == (int)keys.size()) keys.push_back({ uv, handed, V3f(0), V3f(0) });
+
+                keys[k].t += _faceTangents[f];
+                keys[k].b += _faceBitangents[f];
+                cornerKeys[a - begin] = k;
+            }
+
+            for (int a = begin; a < end; ++a)
+            {
+                float* v = stream + (size_t)corners[a] * stride;
+                const V3f n = V3f(v[3], v[4], v[5]).normalized();
+                const TangentKey& key = keys[cornerKeys[a - begin]];
+
+                V3f t = key.t - n * n.dot(key.t);
+                t = t.length2() > 1e-20f ? t.normalized() : perpendicular(n);
+
+                float* o = v + tangentOffset;
+                o[0] = t.x;
+                o[1] = t.y;
+                o[2] = t.z;
+                o[3] = n.cross(t).dot(key.b) < 0 ? -1.0f : 1.0f;
+            }
+        }
+    }
+}
+
+size_t PolyMesh::pack()
+{
+    const bool hasColor = _layout == PosNormColTex;
+    const size_t srcStride = streamVertexSize() / 4;
+    const size_t dstStride = hasColor ? VertexPositionNormalColorTextureCompact::VertexSize()
+        : VertexPositionNormalTextureCompact::VertexSize();
+
+    _packed.resize(_vertexCount * dstStride);
+
+    const float* src = _geom;
+    uint8_t* dst = _packed.data();
+
+    #pragma omp parallel for
+    for (int i = 0; i < _vertexCount; ++i)
+    {
+        const float* v = src + i * srcStride;
+        const float* uv = v + srcStride - 2;
+
+        if (hasColor)
+        {
+            auto* o = reinterpret_cast<VertexPositionNormalColorTextureCompact*>(dst + i * dstStride);
+            o->Position[0] = v[0]; o->Position[1] = v[1]; o->Position[2] = v[2]; o->Position[3] = 1.0f;
+            octEncode(V3f(v[3], v[4], v[5]), o->Normal);
+            for (int c = 0; c < 4; ++c) o->Color[c] = toUnorm8(v[6 + c]);
+            o->TexureCoordinate[0] = uv[0]; o->TexureCoordinate[1] = uv[1];
+        }
+        else
+        {
+            auto* o = reinterpret_cast<VertexPositionNormalTextureCompact*>(dst + i * dstStride);
+            o->Position[0] = v[0]; o->Position[1] = v[1]; o->Position[2] = v[2]; o->Position[3] = 1.0f;
+            octEncode(V3f(v[3], v[4], v[5]), o->Normal);
+            o->TexureCoordinate[0] = uv[0]; o->TexureCoordinate[1] = uv[1];
+        }
+    }
+
+    return _packed.size();
+}
+
+void PolyMesh::updateDirtyRanges(const void* data, size_t sizeInBytes)
+{
+    const size_t chunk = DirtyChunkSize;
+    const int nChunks = (int)((sizeInBytes + chunk - 1) / chunk);
+    const bool resized = (int)_chunkHashes.size() != nChunks;
+
+    _chunkHashes.resize(nChunks);
+    vector<char> dirty(nChunks, 1);
+
+    const char* stream = static_cast<const char*>(data);
+
+    #pragma omp parallel for
+    for (int i = 0; i < nChunks; ++i)
+    {
+        const size_t offset = (size_t)i * chunk;
+        const uint64_t h = hashBytes(stream + offset, std::min(chunk, sizeInBytes - offset));
+
+        dirty[i] = resized || h != _chunkHashes[i];
+        _chunkHashes[i] = h;
+    }
+
+    // merge neighbouring chunks
+    _dirtyRanges.clear();
+    for (int i = 0; i < nChunks; ++i)
+    {
+        if (!dirty[i]) continue;
+
+        const int offset = (int)(i * chunk);
+        const int size = (int)std::min(chunk, sizeInBytes - offset);
+
+        if (!_dirtyRanges.empty() && _dirtyRanges.back().Offset + _dirtyRanges.back().Size == offset)
+            _dirtyRanges.back().Size += size;
+        else
+            _dirtyRanges.emplace_back(offset, size);
+    }
 }
 
 BoundingBox PolyMesh::getBounds()
@@ -1101,7 +2785,11 @@ BoundingBox PolyMesh::getBounds()
 
 int PolyMesh::getMaxVertexCount()
 {
-    if (_maxVertexCount != -1) return _maxVertexCount;
+    PolyMeshInfo& info = *_info;
+
+    // scanned once for all cursors
+    std::lock_guard<std::mutex> lock(info.maxLock);
+    if (info.maxVertexCount != -1) return info.maxVertexCount;
 
     auto& mesh = _polymesh.getSchema();
     auto sampleCount = _topologyVariance == 2 ? _numSamples : 1;
@@ -1125,18 +2813,29 @@ int PolyMesh::getMaxVertexCount()
                 vertexCount += 3 + (count - 3) * 3;
         }
 
-        _maxVertexCount = max(_maxVertexCount, vertexCount);
+        info.maxVertexCount = max(info.maxVertexCount, vertexCount);
 
-        if (_maxVertexCount == vertexCount)
-            _maxVertexTime = _samplingPtr->getSampleTime(i);
+        if (info.maxVertexCount == vertexCount)
+            info.maxVertexTime = _samplingPtr->getSampleTime(i);
     }
 
-    return _maxVertexCount;
+    return info.maxVertexCount;
+}
+
+float PolyMesh::getMaxVertexTime()
+{
+    this->getMaxVertexCount();
+
+    std::lock_guard<std::mutex> lock(_info->maxLock);
+    return (float)_info->maxVertexTime;
 }
 
 BoundingBox PolyMesh::getMaxSizeBoudingBox()
 {
-    if (!_maxBounds.isEmpty()) return toVVVV(_maxBounds);
+    PolyMeshInfo& info = *_info;
+
+    std::lock_guard<std::mutex> lock(info.maxLock);
+    if (!info.maxBounds.isEmpty()) return toVVVV(info.maxBounds);
 
     auto& mesh = _polymesh.getSchema();
     auto sampleCount = _numSamples;
@@ -1147,20 +2846,20 @@ BoundingBox PolyMesh::getMaxSizeBoudingBox()
         mesh.get(meshSample, i);
         auto bound = meshSample.getSelfBounds();
 
-        _maxBounds.min.x = min(_maxBounds.min.x, bound.min.x);
-        _maxBounds.min.y = min(_maxBounds.min.y, bound.min.y);
-        _maxBounds.min.z = min(_maxBounds.min.z, bound.min.z);
+        info.maxBounds.min.x = min(info.maxBounds.min.x, bound.min.x);
+        info.maxBounds.min.y = min(info.maxBounds.min.y, bound.min.y);
+        info.maxBounds.min.z = min(info.maxBounds.min.z, bound.min.z);
 
-        _maxBounds.max.x = max(_maxBounds.max.x, bound.max.x);
-        _maxBounds.max.y = max(_maxBounds.max.y, bound.max.y);
-        _maxBounds.max.z = max(_maxBounds.max.z, bound.max.z);
+        info.maxBounds.max.x = max(info.maxBounds.max.x, bound.max.x);
+        info.maxBounds.max.y = max(info.maxBounds.max.y, bound.max.y);
+        info.maxBounds.max.z = max(info.maxBounds.max.z, bound.max.z);
     }
 
-    return toVVVV(_maxBounds);
+    return toVVVV(info.maxBounds);
 }
 
-Camera::Camera(AbcGeom::ICamera camera)
-    : abcrGeom(camera), _camera(camera), _view(), _proj()
+Camera::Camera(AbcGeom::ICamera camera, const shared_ptr<ObjectInfoCache>& infoCache)
+    : abcrGeom(camera, infoCache), _camera(camera), _view(), _proj()
 {
     _type = AlembicType::CAMERA;
     setMinMaxTime(_camera);
@@ -1200,7 +2899,7 @@ void Camera::set(chrono_t time, Imath::M44f& transform)
         }
         else
         {
-            ISampleSelector ss(time, ISampleSelector::kNearIndex);
+            ISampleSelector ss = getSampleSelector(time, ISampleSelector::kNearIndex);
 
             AbcGeom::CameraSample cam_samp;
             AbcGeom::ICameraSchema camSchema = _camera.getSchema();
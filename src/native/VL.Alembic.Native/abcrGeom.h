@@ -6,10 +6,15 @@
 #include <Alembic\AbcGeom\ICurves.h>
 #include <Alembic\AbcGeom\IXForm.h>
 #include <Alembic\AbcGeom\ICamera.h>
+#include <Alembic\AbcGeom\IFaceSet.h>
 
 #include "abcrUtils.h"
 #include "abcrlayout.h"
 #include "abcrTypes.h"
+#include "abcrSpatial.h"
+
+#include <mutex>
+#include <tuple>
 
 using namespace std;
 
@@ -39,6 +44,74 @@ namespace AlembicType
     };
 }
 
+namespace CurveTessellation
+{
+    enum Mode
+    {
+        LINES = 0,
+        RIBBON,
+        TUBE
+    };
+}
+
+// floor / ceil / near sample of one time on one TimeSampling
+struct SampleTime
+{
+    index_t floorIndex = 0;
+    index_t ceilIndex = 0;
+    index_t nearIndex = 0;
+
+    chrono_t floorTime = 0;
+    chrono_t ceilTime = 0;
+
+    static SampleTime resolve(const TimeSamplingPtr& sampling, size_t numSamples, chrono_t time);
+};
+
+// resolves every distinct TimeSampling once per update instead of once per object,
+// objects of an archive share a handful of them
+class SampleResolver
+{
+public:
+
+    void setTime(chrono_t time)
+    {
+        _isFrame = false;
+        if (time == _time && !_cache.empty()) return;
+
+        _time = time;
+        _cache.clear();
+    }
+
+    // time of frame / fps, indices come from per TimeSampling tables built once per fps
+    void setFrame(int frame, double fps);
+
+    chrono_t getTime() const { return _time; }
+
+    void addSampling(const TimeSamplingPtr& sampling, size_t numSamples);
+
+    const SampleTime& resolve(const TimeSamplingPtr& sampling, size_t numSamples);
+
+private:
+
+    typedef pair<const AbcA::TimeSampling*, size_t> SamplingKey;
+
+    chrono_t _time = 0;
+    map<SamplingKey, SampleTime> _cache;
+
+    // every TimeSampling of the archive, registered at open
+    map<SamplingKey, TimeSamplingPtr> _samplings;
+
+    // frame tables, frames before _firstFrame or past the end resolve like the first / last entry
+    map<SamplingKey, vector<SampleTime>> _frameTables;
+    double _tableFps = 0;
+    int _firstFrame = 0;
+
+    bool _isFrame = false;
+    int _frame = 0;
+
+    void buildFrameTables(double fps);
+};
+
 template <typename T>
 inline AlembicType::Type type2enum() { return AlembicType::UNKNOWN; }
 
@@ -57,6 +130,8 @@ inline AlembicType::Type type2enum<PolyMesh>() { return AlembicType::POLYMESH; }
 template <>
 inline AlembicType::Type type2enum<Camera>() { return AlembicType::CAMERA; }
 
+class ObjectInfoCache;
+
 class abcrGeom
 {
     friend class abcrScene;
@@ -64,7 +139,7 @@ class abcrGeom
 public:
 
     abcrGeom();
-    abcrGeom(IObject obj);
+    abcrGeom(IObject obj, const shared_ptr<ObjectInfoCache>& infoCache = nullptr);
     virtual ~abcrGeom();
 
     virtual bool valid() const { return _obj; };
@@ -94,7 +169,18 @@ public:
 
     virtual void setInterpolate(bool interpolate) { _isInterpolate = interpolate; }
 
-    void setUpNodeRecursive(IObject obj);
+    // offset the floor sample by its velocities instead of blending two samples
+    void setExtrapolate(bool extrapolate) { _isExtrapolate = extrapolate; }
+
+    // raw array of a named property of the current sample: P, velocities, id, width, N, uv or any arbGeomParam.
+    // points into the alembic sample unless it has to be blended or expanded from indices
+    bool getAttribute(const string& name, AttributeStream* o);
+    const vector<string>& getAttributeNames();
+
+    // shared per update sample resolution, objects without one resolve their own
+    void setSampleResolver(SampleResolver* resolver);
+
+    void setUpNodeRecursive(IObject obj, const shared_ptr<ObjectInfoCache>& infoCache);
     static void setUpDocRecursive(shared_ptr<abcrGeom>& obj, map<string, shared_ptr<abcrGeom>>& nameMap, map<string, shared_ptr<abcrGeom>>& fullnameMap);
 
 protected:
@@ -117,18 +203,60 @@ protected:
     virtual void updateTimeSample(chrono_t time, Imath::M44f& transform);
     virtual void set(chrono_t time, Imath::M44f& transform) {};
 
+    // take over the user settings of the same object of another tree, used by the double buffered update
+    virtual void copySettings(const abcrGeom& source) {}
+
+    // line up the incremental outputs (dirty ranges, unchanged index and static stream flags) with the last
+    // output of the same object of the front tree, so the next update reports changes against what was shown
+    virtual void copyHistory(const abcrGeom& source) {}
+
     void getInterpolateSampleSelector(chrono_t time, ISampleSelector& ss0, ISampleSelector& ss1, chrono_t& t);
 
+    // index based selector of the floor / ceil / near sample of time
+    ISampleSelector getSampleSelector(chrono_t time, ISampleSelector::TimeIndexType type);
+    const SampleTime& resolveSample(chrono_t time);
+
+    // ss of a property on another TimeSampling than the schema, arbitrary params may have their own
+    ISampleSelector getPropertySelector(const ISampleSelector& ss, const TimeSamplingPtr& sampling) const;
+
     template<typename T>
     void setMinMaxTime(T& obj);
 
     bool _isUpdate = true;
+
+    // keep the current sample and only follow the parent transform, set by the budgeted update
+    bool _skipSample = false;
     index_t _lastSampleIndex = 0;
 
     bool _isInterpolate = false;
-    double _t;
+    double _t = 0;
+    index_t _blendSampleIndex = 0;
+
+    bool _isExtrapolate = false;
+    float _dt = 0;
 
     TimeSamplingPtr _samplingPtr;
+
+    SampleResolver* _resolver = nullptr;
+    SampleTime _sampleTime;
+
+    // schema properties getAttribute looks up, invalid for geoms without attributes
+    virtual ICompoundProperty getGeomProperties() { return ICompoundProperty(); }
+
+    // index in the second sample of every element of the first when blending, nullptr when the order is kept
+    virtual const vector<int>* getBlendMatch() const { return nullptr; }
+
+    // points kept by the LOD when an attribute of count elements is per point, nullptr keeps all
+    virtual const vector<int>* getPointSelection(size_t count) const { return nullptr; }
+
+private:
+
+    const AbcA::PropertyHeader* findAttribute(const string& name, ICompoundProperty& parent);
+
+    // samples handed out by getAttribute stay alive until the next call with the same name
+    map<string, AbcA::ArraySamplePtr> _attributeSamples;
+    map<string, vector<uint8_t>> _attributeBuffers;
+    vector<string> _attributeNames;
 };
 
 class XForm : public abcrGeom
@@ -137,7 +265,7 @@ public:
 
     Imath::M44f _matrix;
 
-    XForm(AbcGeom::IXform xform);
+    XForm(AbcGeom::IXform xform, const shared_ptr<ObjectInfoCache>& infoCache = nullptr);
     ~XForm()
     {
         if (_xform) _xform.reset();
@@ -157,7 +285,7 @@ class Points : public abcrGeom
 {
 public:
 
-    Points(AbcGeom::IPoints points);
+    Points(AbcGeom::IPoints points, const shared_ptr<ObjectInfoCache>& infoCache = nullptr);
     ~Points() 
     {
         if (_points) _points.reset();
@@ -165,10 +293,20 @@ public:
 
     const char* getTypeNmae() const { return "Points"; }
     int getPointCount() const { return _pointCount; }
+    int getSourcePointCount() const { return _positions ? (int)_positions->size() : 0; }
     void set(chrono_t time, Imath::M44f& transform) override;
 
     bool get(float* o);
 
+    // keep the points whose id hashes below fraction, the same ids stay selected on every frame.
+    // getPointCount and get only cover the selection, skipped points are never blended. applies to the shown sample at once
+    void setLOD(float fraction);
+
+    // keep a grid of the evaluated positions for neighbour queries, rebuilt when the sample changes
+    void setSpatialIndex(bool enable);
+    int queryRadius(const V3f& center, float radius, int maxCount, int* oindices, float* odistances);
+    int queryNearest(const V3f& center, int k, int* oindices, float* odistances);
+
 private:
 
     AbcGeom::IPoints _points;
@@ -176,6 +314,44 @@ private:
     P3fArraySamplePtr _positions;
     P3fArraySamplePtr _positions2;
 
+    UInt64ArraySamplePtr _ids;
+    UInt64ArraySamplePtr _ids2;
+
+    V3fArraySamplePtr _velocities;
+
+    // index in the second sample of every point of the first, -1 when the id is gone.
+    // empty when both samples are in the same order
+    vector<int> _matchIndex;
+    vector<pair<uint64_t, int>> _sortedIds;
+
+    bool matchIds();
+
+    float _lodFraction = 1;
+    vector<int> _lodIndices;
+    int64_t _lodSampleIndex = -1;
+
+    void selectLOD();
+
+    bool _useSpatialIndex = false;
+    PointGrid _grid;
+    vector<V3f> _gridPositions;
+
+    // sample the grid was built from
+    int64_t _gridSampleIndex = -1;
+    double _gridT = 0;
+    float _gridDt = 0;
+
+    void updateSpatialIndex();
+
+    void copySettings(const abcrGeom& source) override;
+
+    ICompoundProperty getGeomProperties() override { return _points.getSchema(); }
+    const vector<int>* getBlendMatch() const override { return _matchIndex.empty() ? nullptr : &_matchIndex; }
+    const vector<int>* getPointSelection(size_t count) const override
+    {
+        return _lodFraction < 1 && _positions && count == _positions->size() ? &_lodIndices : nullptr;
+    }
+
     int _pointCount;
 };
 
@@ -186,7 +362,7 @@ public:
     uint32_t* _index = nullptr;
     float* _geom = nullptr;
 
-    Curves(AbcGeom::ICurves _curves);
+    Curves(AbcGeom::ICurves _curves, const shared_ptr<ObjectInfoCache>& infoCache = nullptr);
     ~Curves()
     {
         if (_curves) _curves.reset();
@@ -204,21 +380,191 @@ public:
     void resizeIndex(size_t size);
     void resizeGeom(size_t size);
 
-    void get(DataPointer* ogeom, DataPointer* oidx);
+    // returns true when the index buffer is the same as the previous call
+    bool get(DataPointer* ogeom, DataPointer* oidx);
+
+    // expand curves into ribbons or tubes as VertexPositionNormalTexture triangle list
+    bool getTessellated(CurveTessellation::Mode mode, int sides, float widthScale, const V3f& view,
+        DataPointer* ogeom, DataPointer* oidx);
+
+    // number of points evaluated per span of cubic and nurbs curves, 0 uses the control points as is
+    void setSubdivision(int subdivision) { _subdivision = std::max(subdivision, 0); }
 
 private:
 
+    const V3f* evaluatePositions();
+    const V3f* refine(const V3f* pts);
+
     AbcGeom::ICurves _curves;
     AbcGeom::ICurvesSchema::Sample _curveSample;
     AbcGeom::ICurvesSchema::Sample _curveSample2;
 
-    int _pointCount;
-    int _indexCount;
+    int _pointCount = 0;
+    int _indexCount = 0;
+
+    int _indexCapacity = 0;
+    int _pointCapacity = 0;
+
+    AbcA::ArraySampleKey _numVerticesKey;
+    AbcA::ArraySampleKey _indexKey;
+    bool _hasNumVerticesKey = false;
+    bool _hasIndex = false;
+
+    vector<float> _tessGeom;
+    vector<uint32_t> _tessIndex;
+    vector<size_t> _curveOffsets;
+    vector<size_t> _segmentOffsets;
+
+    AbcA::ArraySampleKey _tessIndexKey;
+    bool _hasTessIndex = false;
+    int _tessRing = 0;
 
-    int _indexCapacity;
-    int _pointCapacity;
+    int _subdivision = 0;
+    int _indexSubdivision = 0;
+    int _tessSubdivision = 0;
+
+    int _curveCount = 0;
+    const Alembic::Util::int32_t* _numVertices = nullptr;
+
+    vector<V3f> _refined;
+    vector<Alembic::Util::int32_t> _refinedNumVertices;
+    vector<size_t> _refinedOffsets;
+    vector<size_t> _sourceOffsets;
+    vector<size_t> _knotOffsets;
 
     AbcGeom::MeshTopologyVariance _topologyVariance;
+
+    void copySettings(const abcrGeom& source) override
+    {
+        _subdivision = static_cast<const Curves&>(source)._subdivision;
+    }
+
+    void copyHistory(const abcrGeom& source) override;
+};
+
+// attributes of the split vertex streams, always in this order within a stream
+namespace VertexStream
+{
+    enum Attribute
+    {
+        POSITION = 1,
+        NORMAL = 2,
+        COLOR = 4,
+        TEXCOORD = 8
+    };
+
+    inline size_t floatCount(int mask)
+    {
+        return ((mask & POSITION) ? 3 : 0) + ((mask & NORMAL) ? 3 : 0) + ((mask & COLOR) ? 4 : 0) + ((mask & TEXCOORD) ? 2 : 0);
+    }
+}
+
+// First / Count in vertices of the triangle list stream
+struct FaceSetRange
+{
+    string Name;
+    int First;
+    int Count;
+
+    FaceSetRange(const string& name, int first, int count) : Name(name), First(first), Count(count) {}
+};
+
+// corners of the triangle list around every point, start has a entry per point + 1
+struct PointCorners
+{
+    vector<int> start;
+    vector<int> corners;
+};
+
+// triangulation, face set order and point corners of one face indices / face counts sample,
+// shared by every cursor of an archive. the corners are built on first use and only ever
+// replaced as a whole, readers keep the snapshot they got
+struct MeshTopology
+{
+    vector<Imath::Vec3<uint32_t>> triangles;
+    vector<int> triangleFaces;
+    vector<FaceSetRange> faceSets;
+
+    std::mutex adjacencyLock;
+    shared_ptr<const PointCorners> adjacency;
+};
+
+// sample keys a MeshTopology is built from, the faces of every face set included
+// since face sets can be animated while the faces stay the same
+struct TopologyKey
+{
+    AbcA::ArraySampleKey indices;
+    AbcA::ArraySampleKey counts;
+    vector<AbcA::ArraySampleKey> faceSets;
+
+    bool operator==(const TopologyKey& o) const
+    {
+        return indices == o.indices && counts == o.counts && faceSets == o.faceSets;
+    }
+
+    bool operator<(const TopologyKey& o) const
+    {
+        return tie(indices, counts, faceSets) < tie(o.indices, o.counts, o.faceSets);
+    }
+};
+
+// topologies of the meshes of one archive by object and topology keys, held weakly
+// so an entry lives as long as some cursor still shows it
+class TopologyCache
+{
+public:
+
+    shared_ptr<MeshTopology> find(const string& name, const TopologyKey& key);
+    void insert(const string& name, const TopologyKey& key, const shared_ptr<MeshTopology>& topology);
+
+private:
+
+    typedef pair<string, TopologyKey> Key;
+
+    std::mutex _lock;
+    map<Key, weak_ptr<MeshTopology>> _entries;
+};
+
+// what a PolyMesh reads from its schema independent of time, read once and shared by every cursor of an archive
+struct PolyMeshInfo
+{
+    bool hasNormal = false;
+    bool hasUV = false;
+    bool hasRGB = false;
+    bool hasRGBA = false;
+    string rgbName;
+    string rgbaName;
+
+    VertexLayout layout = VertexLayout::PosNormTex;
+    size_t vertexSize = 0;
+    AbcGeom::MeshTopologyVariance topologyVariance = AbcGeom::kConstantTopology;
+
+    bool constant = false;
+    bool positionsConstant = false;
+    bool normalsConstant = false;
+    bool uvsConstant = false;
+    bool colorsConstant = false;
+
+    // scanned over every sample on first use
+    std::mutex maxLock;
+    int maxVertexCount = -1;
+    chrono_t maxVertexTime = 0;
+    Imath::Box3d maxBounds;
+
+    static shared_ptr<PolyMeshInfo> read(AbcGeom::IPolyMesh& pmesh);
+};
+
+// time independent object data of an archive by full name
+class ObjectInfoCache
+{
+public:
+
+    shared_ptr<PolyMeshInfo> polyMesh(AbcGeom::IPolyMesh& pmesh);
+
+private:
+
+    std::mutex _lock;
+    map<string, shared_ptr<PolyMeshInfo>> _polyMeshes;
 };
 
 class PolyMesh : public abcrGeom
@@ -227,7 +573,7 @@ public:
 
     float* _geom = nullptr;
 
-    PolyMesh(AbcGeom::IPolyMesh pmesh);
+    PolyMesh(AbcGeom::IPolyMesh pmesh, const shared_ptr<ObjectInfoCache>& infoCache = nullptr);
     ~PolyMesh()
     {
         if (_polymesh) _polymesh.reset();
@@ -236,8 +582,16 @@ public:
 
     const char* getTypeNmae() const { return "PolyMesh"; }
     int getVertexCount() const { return _vertexCount; }
-    size_t getVertexSize() const { return _vertexSize; }
-    VertexLayout getVertexLayout() const { return _layout; }
+    size_t getVertexSize() const { return streamVertexSize(); }
+
+    // layout of the interleaved stream get returns. tangent meshes are never split,
+    // the tangent layouts only exist interleaved
+    VertexLayout getVertexLayout() const
+    {
+        if (_compact) return _layout == PosNormColTex ? PosNormColTexCompact : PosNormTexCompact;
+        if (hasTangents()) return _layout == PosNormColTex ? PosNormColTanTex : PosNormTanTex;
+        return _layout;
+    }
     AbcGeom::MeshTopologyVariance getTopologyVariance() const { return _topologyVariance; }
     void set(chrono_t time, Imath::M44f& transform) override;
 
@@ -245,13 +599,75 @@ public:
 
     void resize(size_t size);
 
+    // interleaved stream described by getVertexLayout / getVertexSize, also when split streams are on
     float* get(int* size);
 
+    // dynamic stream of a split mesh, the static one through getStaticStream. null when not split
+    float* getSplit(int* size);
+
+    // build the stream ahead on the update thread. get and getSplit return it as is until the next set
+    // picks other samples or a setting changes, objects skipped by a budgeted update keep theirs
+    void prepare();
+
+    // pack the stream into the half / octahedral layouts
+    void setCompact(bool compact) { _compact = compact; _prepared = false; }
+
+    // angle weighted normals shared across faces for meshes without normals,
+    // edges sharper than hardEdgeAngle degrees stay split
+    void setSmoothNormals(bool smooth, float hardEdgeAngle)
+    {
+        _smoothNormals = smooth;
+        _hardEdgeAngle = hardEdgeAngle;
+        _staticValid = false;
+        _prepared = false;
+    }
+
+    // let getSplit write animated attributes into a dynamic stream and constant ones into a static stream
+    // that is only rewritten when the topology changes. ignored by compact, tangent and heterogeneous meshes
+    void setSplitStreams(bool split)
+    {
+        _splitStreams = split;
+        _staticValid = false;
+        _prepared = false;
+    }
+
+    bool isSplit() const
+    {
+        return _splitStreams && !_compact && !hasTangents() && _topologyVariance != AbcGeom::kHeterogeneousTopology;
+    }
+
+    // VertexStream bits of the dynamic or the static stream
+    int getStreamMask(bool dynamic) const;
+
+    // static stream of the last getSplit, true when that getSplit rewrote it
+    const float* getStaticStream(int* size) const;
+    bool isStaticStreamWritten() const { return _staticWritten; }
+
+    // vertex range of every face set in the stream, triangles are sorted by face set
+    const vector<FaceSetRange>& getFaceSets() const;
+
+    // point index of every stream vertex of the current sample, in the order get writes them
+    bool getStreamPoints(vector<int>& o);
+
+    // share triangulations with the other cursors of the archive
+    void setTopologyCache(const shared_ptr<TopologyCache>& cache) { _topologyCache = cache; }
+
+    // float4 tangent before the uv, needs uvs. the compact layouts drop it and it turns split streams off
+    void setTangents(bool tangents) { _tangents = tangents; _prepared = false; }
+
+    // compare the stream per chunk against the previous get
+    void setDirtyTracking(bool track) { _trackDirty = track; _chunkHashes.clear(); _prepared = false; }
+    const DataRange* getDirtyRanges(int* count) const
+    {
+        *count = (int)_dirtyRanges.size();
+        return _dirtyRanges.data();
+    }
+
     BoundingBox getBounds();
 
     int getMaxVertexCount();
     BoundingBox getMaxSizeBoudingBox();
-    inline float getMaxVertexTime() const { return _maxVertexTime; }
+    float getMaxVertexTime();
 
 private:
 
@@ -285,12 +701,85 @@ private:
     int _vertexCount;
     int _capacity;
 
-    int _maxVertexCount = -1;
-    Imath::Box3d _maxBounds = Imath::Box3d();
-
     AbcGeom::MeshTopologyVariance _topologyVariance;
 
-    chrono_t _maxVertexTime = 0;
+    shared_ptr<PolyMeshInfo> _info;
+
+    static const size_t DirtyChunkSize = 1 << 16;
+
+    bool _trackDirty = false;
+    vector<uint64_t> _chunkHashes;
+    vector<DataRange> _dirtyRanges;
+
+    void updateDirtyRanges(const void* stream, size_t sizeInBytes);
+
+    bool _compact = false;
+    vector<uint8_t> _packed;
+
+    vector<V3f> _extrapolated;
+
+    size_t pack();
+
+    // triangulation of the face indices and the corners around every point, kept while the topology keys match
+    TopologyKey _faceKey;
+    bool _hasFaceKeys = false;
+
+    TopologyKey _topologyKey;
+    bool _hasTopology = false;
+
+    shared_ptr<MeshTopology> _topology;
+    shared_ptr<TopologyCache> _topologyCache;
+
+    bool updateTopology(const Int32ArraySamplePtr& faceIndices, const Int32ArraySamplePtr& faceCounts);
+    void sortByFaceSets(MeshTopology& topology, size_t nFace);
+    bool readFaceSetKeys(vector<AbcA::ArraySampleKey>& keys);
+
+    shared_ptr<const PointCorners> updateAdjacency(const int32_t* indices, size_t nPts);
+
+    bool _smoothNormals = false;
+    float _hardEdgeAngle = 180;
+
+    vector<N3f> _faceNormals;
+    vector<float> _cornerWeights;
+    vector<N3f> _cornerNormals;
+    vector<V3f> _blendedPoints;
+
+    void computeSmoothNormals(const V3f* points, const int32_t* indices, size_t nPts);
+
+    bool _positionsConstant = false;
+    bool _normalsConstant = false;
+    bool _uvsConstant = false;
+    bool _colorsConstant = false;
+
+    bool _splitStreams = false;
+    bool _staticValid = false;
+    bool _staticWritten = false;
+    int _staticMask = 0;
+    vector<float> _dynamicStream;
+    vector<float> _staticStream;
+
+    bool _tangents = false;
+    vector<V3f> _faceTangents;
+    vector<V3f> _faceBitangents;
+
+    bool hasTangents() const { return _tangents && _hasUV; }
+    size_t streamVertexSize() const { return _vertexSize + (hasTangents() ? sizeof(Imath::V4f) : 0); }
+
+    void computeTangents(const int32_t* indices, size_t nPts);
+
+    bool _prepared = false;
+    float* _preparedStream = nullptr;
+    int _preparedSize = 0;
+    bool _preparedSplit = false;
+    bool _preparedServed = false;
+
+    float* take(int* size, bool split);
+    float* assemble(int* size, bool split);
+
+    void copySettings(const abcrGeom& source) override;
+    void copyHistory(const abcrGeom& source) override;
+
+    ICompoundProperty getGeomProperties() override { return _polymesh.getSchema(); }
 };
 
 class Camera : public abcrGeom
@@ -299,7 +788,7 @@ public:
     Matrix4x4 _view;
     CameraParam _proj;
 
-    Camera(AbcGeom::ICamera camera);
+    Camera(AbcGeom::ICamera camera, const shared_ptr<ObjectInfoCache>& infoCache = nullptr);
     ~Camera()
     {
         if (_camera) _camera.reset();
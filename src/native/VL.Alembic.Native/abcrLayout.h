@@ -1,5 +1,7 @@
 #pragma once
 
+#include <half.h>
+
 struct VertexPositionNormalTexture
 {
 public:
@@ -27,14 +29,72 @@ public:
     }
 };
 
+// tangent xyz with the bitangent handedness in w
+struct VertexPositionNormalTangentTexture
+{
+public:
+    V3f Position;
+    N3f Normal;
+    Imath::V4f Tangent;
+    V2f TexureCoordinate;
+
+    const static int VertexSize()
+    {
+        return sizeof(VertexPositionNormalTangentTexture);
+    }
+};
+
+struct VertexPositionNormalColorTangentTexture
+{
+public:
+    V3f Position;
+    N3f Normal;
+    C4f Color;
+    Imath::V4f Tangent;
+    V2f TexureCoordinate;
+
+    const static int VertexSize()
+    {
+        return sizeof(VertexPositionNormalColorTangentTexture);
+    }
+};
+
+// half position, octahedral snorm16 normal, half uv
+struct VertexPositionNormalTextureCompact
+{
+public:
+    half Position[4];
+    int16_t Normal[2];
+    half TexureCoordinate[2];
+
+    const static int VertexSize()
+    {
+        return sizeof(VertexPositionNormalTextureCompact);
+    }
+};
+
+// half position, octahedral snorm16 normal, rgba8 color, half uv
+struct VertexPositionNormalColorTextureCompact
+{
+public:
+    half Position[4];
+    int16_t Normal[2];
+    uint8_t Color[4];
+    half TexureCoordinate[2];
+
+    const static int VertexSize()
+    {
+        return sizeof(VertexPositionNormalColorTextureCompact);
+    }
+};
+
 enum VertexLayout
 {
     PosNormTex = 0,
     PosNormColTex,
+    PosNormTexCompact,
+    PosNormColTexCompact,
+    PosNormTanTex,
+    PosNormColTanTex,
     Unknown
-};
-
-// TODO : calc Tangents at runtime
-// https://github.com/stride3d/stride/blob/master/sources/engine/Stride.Graphics/VertexHelper.cs#L219-L393
-
-#define TANGENT 4 // (xyz:tangent, w:handed)
\ No newline at end of file
+};
\ No newline at end of file
@@ -1,45 +1,384 @@
 #include "abcrScene.h"
 
+#include <sys/stat.h>
+
+std::mutex ArchiveRegistry::_lock;
+map<string, ArchiveRegistry::Entry> ArchiveRegistry::_entries;
+
+string ArchiveRegistry::canonicalPath(const string& path)
+{
+#ifdef _WIN32
+    char full[_MAX_PATH];
+    if (!_fullpath(full, path.c_str(), _MAX_PATH)) return path;
+
+    // case insensitive file system
+    string result(full);
+    for (auto& c : result)
+    {
+        if (c == '/') c = '\\';
+        c = (char)tolower((unsigned char)c);
+    }
+    return result;
+#else
+    char* full = realpath(path.c_str(), nullptr);
+    if (!full) return path;
+
+    string result(full);
+    free(full);
+    return result;
+#endif
+}
+
+bool ArchiveRegistry::fileIdentity(const string& path, FileIdentity& o)
+{
+#ifdef _WIN32
+    struct _stat64 st;
+    if (_stat64(path.c_str(), &st) != 0) return false;
+#else
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return false;
+#endif
+
+    o.size = (int64_t)st.st_size;
+    o.modified = (int64_t)st.st_mtime;
+    return true;
+}
+
+shared_ptr<SharedArchive> ArchiveRegistry::acquire(const string& path)
+{
+    const string key = canonicalPath(path);
+
+    FileIdentity identity;
+    if (!fileIdentity(key, identity)) return nullptr;
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    // drop the archives no scene holds anymore
+    for (auto it = _entries.begin(); it != _entries.end();)
+    {
+        if (it->second.archive.expired()) it = _entries.erase(it);
+        else ++it;
+    }
+
+    auto it = _entries.find(key);
+    if (it != _entries.end() && it->second.identity == identity)
+        return it->second.archive.lock();
+
+    auto shared = make_shared<SharedArchive>();
+    shared->archive = IArchive(AbcCoreOgawa::ReadArchive(), key,
+        Alembic::Abc::ErrorHandler::kQuietNoopPolicy);
+
+    if (!shared->archive.valid()) return nullptr;
+
+    shared->path = path;
+
+    // scenes on the previous version of a rewritten file keep theirs
+    Entry& entry = _entries[key];
+    entry.identity = identity;
+    entry.archive = shared;
+
+    return shared;
+}
+
 abcrScene::abcrScene() {}
 
 abcrScene::~abcrScene() 
 {
+    if (_pending.valid()) _pending.wait();
+    _back.reset();
+
     this->_nameMap.clear();
     this->_fullnameMap.clear();
 
     if (_top) _top.reset();
-    if (_archive.valid()) _archive.reset();
+    if (_archive) _archive.reset();
 }
 
 bool abcrScene::open(const string& path)
 {
-    _archive = IArchive(AbcCoreOgawa::ReadArchive(), path,
-        Alembic::Abc::ErrorHandler::kQuietNoopPolicy);
+    _archive = ArchiveRegistry::acquire(path);
+    if (!_archive) return false;
+
+    _path = path;
 
-    if (!_archive.valid()) return false;
+    this->setUp();
+
+    return true;
+}
+
+bool abcrScene::openCursor(const abcrScene& source)
+{
+    if (!source._archive) return false;
+
+    // same archive reader, so the file, its streams and the object headers are not read again
+    _archive = source._archive;
+    _path = source._path;
+
+    _isInterpolate = source._isInterpolate;
+    _isExtrapolate = source._isExtrapolate;
+
+    this->setUp();
+
+    return true;
+}
+
+void abcrScene::setUp()
+{
+    // the tree holds the sample state of this cursor, what every cursor would read the same comes from the archive
+    _top.reset( new abcrGeom(_archive->archive.getTop(), _archive->objectInfo) );
 
-    _top.reset( new abcrGeom(_archive.getTop()) );
-        
     this->_nameMap.clear();
     this->_fullnameMap.clear();
     abcrGeom::setUpDocRecursive(_top, _nameMap, _fullnameMap);
-        
+    _top->setSampleResolver(&_resolver);
+
+    for (auto& geom : _fullnameMap)
+    {
+        if (geom.second->isTypeOf<PolyMesh>())
+            static_cast<PolyMesh*>(geom.second.get())->setTopologyCache(_archive->topologyCache);
+    }
+
     _minTime = _top->_minTime;
     _maxTime = _top->_maxTime;
-
-    return true;
 }
 
 bool abcrScene::updateSample(chrono_t time)
 {
     if (!_top) return false;
+    if (_pending.valid()) endUpdate();
+
+    auto begin = chrono::steady_clock::now();
 
-    ISampleSelector ss(time, ISampleSelector::kNearIndex);
+    _resolver.setTime(time);
+    update(time);
+    markUpdated(time);
 
+    _lastUpdateDuration = chrono::duration<float, milli>(chrono::steady_clock::now() - begin).count();
+
+    return true;
+}
+
+bool abcrScene::updateFrame(int frame, double fps)
+{
+    if (!_top || fps <= 0) return false;
+    if (_pending.valid()) endUpdate();
+
+    auto begin = chrono::steady_clock::now();
+
+    _resolver.setFrame(frame, fps);
+    update((double)frame / fps);
+    markUpdated((double)frame / fps);
+
+    _lastUpdateDuration = chrono::duration<float, milli>(chrono::steady_clock::now() - begin).count();
+
+    return true;
+}
+
+void abcrScene::update(chrono_t time)
+{
     Imath::M44f m;
     m.makeIdentity();
     _top->setInterpolate(_isInterpolate);
+    _top->setExtrapolate(_isExtrapolate);
     _top->updateTimeSample(time, m);
+}
+
+bool abcrScene::beginUpdate(chrono_t time)
+{
+    if (!_top || _pending.valid()) return false;
+
+    _pendingTime = time;
 
+    if (!_back)
+    {
+        _back.reset(new abcrScene());
+        if (!_back->openCursor(*this))
+        {
+            _back.reset();
+            return false;
+        }
+    }
+
+    _back->_isInterpolate = _isInterpolate;
+    _back->_isExtrapolate = _isExtrapolate;
+
+    // settings changed on the front since the last swap, and the front's last output as the base
+    // of the incremental outputs, the back tree last showed the frame before it
+    for (auto& geom : _fullnameMap)
+    {
+        auto it = _back->_fullnameMap.find(geom.first);
+        if (it == _back->_fullnameMap.end()) continue;
+
+        it->second->copySettings(*geom.second);
+        it->second->copyHistory(*geom.second);
+    }
+
+    abcrScene* back = _back.get();
+    _pending = async(launch::async, [back, time]()
+    {
+        back->updateSample(time);
+        back->prepare();
+    });
+
+    return true;
+}
+
+bool abcrScene::endUpdate()
+{
+    if (!_pending.valid()) return false;
+
+    _pending.get();
+
+    swap(_top, _back->_top);
+    swap(_nameMap, _back->_nameMap);
+    swap(_fullnameMap, _back->_fullnameMap);
+    swap(_resolver, _back->_resolver);
+
+    _top->setSampleResolver(&_resolver);
+    _back->_top->setSampleResolver(&_back->_resolver);
+
+    _lastUpdateDuration = _back->_lastUpdateDuration;
+    markUpdated(_pendingTime);
+
+    return true;
+}
+
+void abcrScene::prepare()
+{
+    for (auto& geom : _fullnameMap)
+    {
+        if (geom.second->isTypeOf<PolyMesh>())
+            static_cast<PolyMesh*>(geom.second.get())->prepare();
+    }
+}
+
+void abcrScene::setUpSchedule()
+{
+    if (!_schedule.empty()) return;
+
+    for (auto& geom : _fullnameMap)
+    {
+        if (!geom.second->isTypeOf<Points>() && !geom.second->isTypeOf<Curves>() && !geom.second->isTypeOf<PolyMesh>())
+            continue;
+
+        ScheduleEntry entry;
+        entry.name = geom.first;
+
+        _scheduleIndex[geom.first] = _schedule.size();
+        _schedule.push_back(entry);
+    }
+}
+
+void abcrScene::markUpdated(chrono_t time)
+{
+    for (auto& entry : _schedule)
+    {
+        entry.staleFrames = 0;
+        entry.sampleTime = time;
+    }
+}
+
+bool abcrScene::updateBudgeted(chrono_t time, float budget)
+{
+    if (!_top) return false;
+    if (_pending.valid()) endUpdate();
+
+    auto begin = chrono::steady_clock::now();
+
+    this->setUpSchedule();
+
+    // the tree may have been swapped by endUpdate since the last call
+    for (auto& entry : _schedule)
+    {
+        entry.geom = _fullnameMap.at(entry.name).get();
+        entry.geom->_skipSample = true;
+    }
+
+    _resolver.setTime(time);
+    update(time);
+
+    for (auto& entry : _schedule) entry.geom->_skipSample = false;
+
+    // never measured first, then the objects furthest behind weighted by priority
+    vector<pair<float, size_t>> order(_schedule.size());
+    for (size_t i = 0; i < _schedule.size(); ++i)
+    {
+        const ScheduleEntry& entry = _schedule[i];
+        const float score = entry.cost < 0 ? numeric_limits<float>::max() : entry.priority * (1 + entry.staleFrames);
+        order[i] = make_pair(-score, i);
+    }
+    sort(order.begin(), order.end());
+
+    vector<bool> updated(_schedule.size(), false);
+    bool any = false;
+
+    // objects never measured are expected to cost the average of the measured ones
+    float measuredCost = 0;
+    int measured = 0;
+    for (const auto& entry : _schedule)
+    {
+        if (entry.cost < 0) continue;
+        measuredCost += entry.cost;
+        ++measured;
+    }
+
+    for (const auto& o : order)
+    {
+        ScheduleEntry& entry = _schedule[o.second];
+
+        const float elapsed = chrono::duration<float, milli>(chrono::steady_clock::now() - begin).count();
+        const float expected = entry.cost >= 0 ? entry.cost : measured > 0 ? measuredCost / measured : 0;
+        if (any && elapsed + expected > budget) continue;
+
+        auto start = chrono::steady_clock::now();
+
+        Imath::M44f m = entry.geom->_transform;
+        entry.geom->set(time, m);
+        if (entry.geom->isTypeOf<PolyMesh>()) static_cast<PolyMesh*>(entry.geom)->prepare();
+
+        const float cost = chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+        if (entry.cost < 0)
+        {
+            measuredCost += cost;
+            ++measured;
+        }
+        entry.cost = entry.cost < 0 ? cost : entry.cost * 0.75f + cost * 0.25f;
+
+        entry.staleFrames = 0;
+        entry.sampleTime = time;
+
+        updated[o.second] = true;
+        any = true;
+    }
+
+    for (size_t i = 0; i < _schedule.size(); ++i)
+        if (!updated[i]) ++_schedule[i].staleFrames;
+
+    _lastUpdateDuration = chrono::duration<float, milli>(chrono::steady_clock::now() - begin).count();
+
+    return true;
+}
+
+bool abcrScene::setPriority(const string& name, float priority)
+{
+    this->setUpSchedule();
+
+    auto it = _scheduleIndex.find(name);
+    if (it == _scheduleIndex.end()) return false;
+
+    _schedule[it->second].priority = std::max(priority, 0.0f);
     return true;
-}
\ No newline at end of file
+}
+
+bool abcrScene::getStaleness(const string& name, int* frames, float* sampleTime) const
+{
+    *frames = 0;
+    *sampleTime = 0;
+
+    auto it = _scheduleIndex.find(name);
+    if (it == _scheduleIndex.end()) return false;
+
+    *frames = _schedule[it->second].staleFrames;
+    *sampleTime = (float)_schedule[it->second].sampleTime;
+    return true;
+}
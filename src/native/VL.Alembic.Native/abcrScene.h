@@ -3,12 +3,58 @@
 #include <Alembic\Abc\All.h>
 #include <Alembic\AbcCoreOgawa\All.h>
 
+#include <chrono>
+#include <future>
+
 #include "abcrGeom.h"
 
 using namespace std;
 using namespace Alembic;
 using namespace Alembic::Abc;
 
+// an opened archive and what is derived from it independent of time, shared by every scene
+// and cursor on the same file
+struct SharedArchive
+{
+    IArchive archive;
+    string path;
+
+    shared_ptr<TopologyCache> topologyCache = make_shared<TopologyCache>();
+    shared_ptr<ObjectInfoCache> objectInfo = make_shared<ObjectInfoCache>();
+};
+
+// process wide SharedArchive by canonical path, reused while the file on disk is unchanged
+// and freed with the last scene holding it
+class ArchiveRegistry
+{
+public:
+
+    static shared_ptr<SharedArchive> acquire(const string& path);
+
+private:
+
+    // size and modification time, a rewritten file is opened again
+    struct FileIdentity
+    {
+        int64_t size = -1;
+        int64_t modified = 0;
+
+        bool operator==(const FileIdentity& o) const { return size == o.size && modified == o.modified; }
+    };
+
+    struct Entry
+    {
+        FileIdentity identity;
+        weak_ptr<SharedArchive> archive;
+    };
+
+    static std::mutex _lock;
+    static map<string, Entry> _entries;
+
+    static string canonicalPath(const string& path);
+    static bool fileIdentity(const string& path, FileIdentity& o);
+};
+
 class abcrScene
 {
     public:
@@ -18,13 +64,40 @@ class abcrScene
 
         bool open(const string& path);
 
+        // playback state of its own over the SharedArchive of source
+        bool openCursor(const abcrScene& source);
+
         bool updateSample(chrono_t time);
 
+        // update at frame / fps, sample indices are looked up instead of searched
+        bool updateFrame(int frame, double fps);
+
+        // double buffered update: beginUpdate decodes time into a second tree on a worker thread while
+        // the current one stays readable, endUpdate waits for it and makes it the current one
+        bool beginUpdate(chrono_t time);
+        bool endUpdate();
+        bool isUpdating() const { return _pending.valid(); }
+
+        // update transforms and cameras, then Points, Curves and PolyMesh by priority times frames
+        // behind until budget milliseconds are spent, at least one per call. objects not measured yet count as
+        // the average cost of the measured ones. the rest keep their sample and stream for a later frame
+        bool updateBudgeted(chrono_t time, float budget);
+
+        // weight of an object in updateBudgeted, e.g. its screen size
+        bool setPriority(const string& name, float priority);
+
+        // updates an object has missed and the time of the sample it shows
+        bool getStaleness(const string& name, int* frames, float* sampleTime) const;
+
         bool valid() const { return _top->valid(); };
 
         inline float getMaxTime() const { return _maxTime; };
         inline float getMinTime() const { return _minTime; };
         inline size_t getGeomCount() const { return _fullnameMap.size(); };
+        inline const string& getPath() const { return _path; };
+
+        // wall-clock duration of the last updateSample in milliseconds
+        inline float getLastUpdateDuration() const { return _lastUpdateDuration; };
 
         inline map<string, shared_ptr<abcrGeom>>::const_iterator getGeomIterator() const
         {
@@ -48,6 +121,7 @@ class abcrScene
         }
 
         inline void setInterpolate(bool interpolate) { _isInterpolate = interpolate; }
+        inline void setExtrapolate(bool extrapolate) { _isExtrapolate = extrapolate; }
             
         //bool getSample(const string& name, Matrix4x4* xform);                     //XForm
         //bool getSample(const string& name, float* points);                        //Points
@@ -57,7 +131,8 @@ class abcrScene
 
     private:
 
-        IArchive _archive;
+        shared_ptr<SharedArchive> _archive;
+        string _path;
         shared_ptr<abcrGeom> _top;
 
         chrono_t _minTime;
@@ -66,5 +141,41 @@ class abcrScene
         map<string, shared_ptr<abcrGeom>> _nameMap;
         map<string, shared_ptr<abcrGeom>> _fullnameMap;
 
+        // floor / ceil indices of every TimeSampling, shared by all objects for one updateSample
+        SampleResolver _resolver;
+
+        void setUp();
+        void update(chrono_t time);
+
+        // back tree of the double buffered update, a cursor over the same archive
+        unique_ptr<abcrScene> _back;
+        future<void> _pending;
+        chrono_t _pendingTime = 0;
+
+        void prepare();
+
+        struct ScheduleEntry
+        {
+            string name;
+            abcrGeom* geom = nullptr;
+
+            float priority = 1;
+
+            // moving average of decoding and assembly in milliseconds, negative until measured
+            float cost = -1;
+
+            int staleFrames = 0;
+            chrono_t sampleTime = 0;
+        };
+
+        vector<ScheduleEntry> _schedule;
+        map<string, size_t> _scheduleIndex;
+
+        void setUpSchedule();
+        void markUpdated(chrono_t time);
+
         bool _isInterpolate = false;
+        bool _isExtrapolate = false;
+
+        float _lastUpdateDuration = 0;
 };
\ No newline at end of file
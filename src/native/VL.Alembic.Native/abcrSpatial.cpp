@@ -0,0 +1,189 @@
+#include "abcrSpatial.h"
+
+#include <queue>
+
+namespace
+{
+    // about two points per cell, at most 256 cells per axis
+    const float PointsPerCell = 2;
+    const int MaxResolution = 256;
+
+    int writeResults(vector<pair<float, int>>& found, int maxCount, int* oindices, float* odistances)
+    {
+        const int n = std::min((int)found.size(), maxCount);
+        std::partial_sort(found.begin(), found.begin() + n, found.end());
+
+        for (int i = 0; i < n; ++i)
+        {
+            oindices[i] = found[i].second;
+            if (odistances) odistances[i] = sqrtf(found[i].first);
+        }
+
+        return n;
+    }
+}
+
+void PointGrid::clear()
+{
+    _points.clear();
+    _cellStart.clear();
+    _indices.clear();
+}
+
+void PointGrid::build(const V3f* points, int count)
+{
+    clear();
+    if (count <= 0) return;
+
+    _points.assign(points, points + count);
+
+    int numThreads = 1;
+#ifdef _OPENMP
+    numThreads = omp_get_max_threads();
+#endif
+
+    // bounds per thread, msvc has no min / max reductions
+    vector<Imath::Box3f> boxes(numThreads);
+
+    #pragma omp parallel for
+    for (int c = 0; c < numThreads; ++c)
+    {
+        const int begin = (int)((int64_t)count * c / numThreads);
+        const int end = (int)((int64_t)count * (c + 1) / numThreads);
+        for (int i = begin; i < end; ++i) boxes[c].extendBy(_points[i]);
+    }
+
+    _bounds.makeEmpty();
+    for (const auto& b : boxes) _bounds.extendBy(b);
+
+    const V3f size = _bounds.size();
+    const float extent = std::max(size.x, std::max(size.y, size.z));
+
+    // cell edge from the volume of the non flat axes
+    const float cells = std::max(1.0f, count / PointsPerCell);
+    float volume = 1;
+    int dims = 0;
+    for (int a = 0; a < 3; ++a)
+    {
+        if (size[a] > extent * 1e-3f)
+        {
+            volume *= size[a];
+            ++dims;
+        }
+    }
+
+    _cellSize = dims > 0 ? powf(volume / cells, 1.0f / dims) : 1;
+    _cellSize = std::max(_cellSize, extent / MaxResolution);
+    if (_cellSize <= 0) _cellSize = 1;
+
+    for (int a = 0; a < 3; ++a)
+        _resolution[a] = std::max(1, std::min(MaxResolution, (int)ceilf(size[a] / _cellSize)));
+
+    const int numCells = _resolution.x * _resolution.y * _resolution.z;
+
+    vector<pair<int, int>> keys(count);
+
+    #pragma omp parallel for
+    for (int i = 0; i < count; ++i)
+    {
+        const Imath::V3i c = cellOf(_points[i]);
+        keys[i] = make_pair(cellIndex(c.x, c.y, c.z), i);
+    }
+
+    parallelSort(keys);
+
+    _indices.resize(count);
+
+    #pragma omp parallel for
+    for (int i = 0; i < count; ++i)
+        _indices[i] = keys[i].second;
+
+    _cellStart.resize(numCells + 1);
+
+    #pragma omp parallel for
+    for (int c = 0; c <= numCells; ++c)
+        _cellStart[c] = (int)(std::lower_bound(keys.begin(), keys.end(), make_pair(c, -1)) - keys.begin());
+}
+
+int PointGrid::queryRadius(const V3f& center, float radius, int maxCount, int* oindices, float* odistances) const
+{
+    if (empty() || radius < 0 || maxCount <= 0) return 0;
+
+    const Imath::Box3f box(center - V3f(radius), center + V3f(radius));
+    if (!box.intersects(_bounds)) return 0;
+
+    const float r2 = radius * radius;
+    vector<pair<float, int>> found;
+
+    forEachInCells(cellOf(box.min), cellOf(box.max), [&](int i)
+    {
+        const float d2 = (_points[i] - center).length2();
+        if (d2 <= r2) found.push_back(make_pair(d2, i));
+    });
+
+    return writeResults(found, maxCount, oindices, odistances);
+}
+
+int PointGrid::queryNearest(const V3f& center, int k, int* oindices, float* odistances) const
+{
+    if (empty() || k <= 0) return 0;
+
+    k = std::min(k, (int)_points.size());
+
+    // max heap of the best k so far
+    priority_queue<pair<float, int>> best;
+    const Imath::V3i origin = cellOf(center);
+    const int maxRing = std::max(_resolution.x, std::max(_resolution.y, _resolution.z));
+
+    for (int ring = 0; ring <= maxRing; ++ring)
+    {
+        const Imath::V3i lo(origin.x - ring, origin.y - ring, origin.z - ring);
+        const Imath::V3i hi(origin.x + ring, origin.y + ring, origin.z + ring);
+
+        // only the shell of the ring, inner cells were visited already
+        for (int z = std::max(lo.z, 0); z <= std::min(hi.z, _resolution.z - 1); ++z)
+            for (int y = std::max(lo.y, 0); y <= std::min(hi.y, _resolution.y - 1); ++y)
+                for (int x = std::max(lo.x, 0); x <= std::min(hi.x, _resolution.x - 1); ++x)
+                {
+                    if (x != lo.x && x != hi.x && y != lo.y && y != hi.y && z != lo.z && z != hi.z) continue;
+
+                    const int c = cellIndex(x, y, z);
+                    for (int i = _cellStart[c]; i < _cellStart[c + 1]; ++i)
+                    {
+                        const int id = _indices[i];
+                        const float d2 = (_points[id] - center).length2();
+
+                        if ((int)best.size() < k) best.push(make_pair(d2, id));
+                        else if (d2 < best.top().first)
+                        {
+                            best.pop();
+                            best.push(make_pair(d2, id));
+                        }
+                    }
+                }
+
+        if ((int)best.size() < k) continue;
+
+        // anything outside the visited cells is at least this far away
+        float bound = std::numeric_limits<float>::max();
+        for (int a = 0; a < 3; ++a)
+        {
+            const float minEdge = _bounds.min[a] + lo[a] * _cellSize;
+            const float maxEdge = _bounds.min[a] + (hi[a] + 1) * _cellSize;
+            if (lo[a] > 0) bound = std::min(bound, center[a] - minEdge);
+            if (hi[a] < _resolution[a] - 1) bound = std::min(bound, maxEdge - center[a]);
+        }
+
+        if (bound == std::numeric_limits<float>::max() || (bound > 0 && best.top().first <= bound * bound)) break;
+    }
+
+    vector<pair<float, int>> found;
+    found.reserve(best.size());
+    while (!best.empty())
+    {
+        found.push_back(best.top());
+        best.pop();
+    }
+
+    return writeResults(found, k, oindices, odistances);
+}
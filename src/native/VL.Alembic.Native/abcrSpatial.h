@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Alembic\Abc\All.h>
+
+#include "abcrUtils.h"
+
+using namespace std;
+using namespace Alembic::Abc;
+
+// uniform grid over a point cloud. points are sorted by cell so every cell is a contiguous
+// range of _indices, queries return the original point indices nearest first
+class PointGrid
+{
+public:
+
+    void build(const V3f* points, int count);
+    void clear();
+
+    bool empty() const { return _points.empty(); }
+
+    // points within radius of center, at most maxCount
+    int queryRadius(const V3f& center, float radius, int maxCount, int* oindices, float* odistances) const;
+
+    // k nearest points of center
+    int queryNearest(const V3f& center, int k, int* oindices, float* odistances) const;
+
+private:
+
+    vector<V3f> _points;
+
+    Imath::Box3f _bounds;
+    float _cellSize = 1;
+    Imath::V3i _resolution;
+
+    // first entry of every cell in _indices, cell count + 1
+    vector<int> _cellStart;
+    vector<int> _indices;
+
+    inline Imath::V3i cellOf(const V3f& p) const
+    {
+        const V3f c = (p - _bounds.min) / _cellSize;
+        return Imath::V3i(
+            std::max(0, std::min(_resolution.x - 1, (int)floorf(c.x))),
+            std::max(0, std::min(_resolution.y - 1, (int)floorf(c.y))),
+            std::max(0, std::min(_resolution.z - 1, (int)floorf(c.z))));
+    }
+
+    inline int cellIndex(int x, int y, int z) const
+    {
+        return (z * _resolution.y + y) * _resolution.x + x;
+    }
+
+    // visit every point of the cells in [lo, hi]
+    template<typename F>
+    void forEachInCells(const Imath::V3i& lo, const Imath::V3i& hi, F f) const
+    {
+        for (int z = lo.z; z <= hi.z; ++z)
+            for (int y = lo.y; y <= hi.y; ++y)
+                for (int x = lo.x; x <= hi.x; ++x)
+                {
+                    const int c = cellIndex(x, y, z);
+                    for (int i = _cellStart[c]; i < _cellStart[c + 1]; ++i) f(_indices[i]);
+                }
+    }
+};
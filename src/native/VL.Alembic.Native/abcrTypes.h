@@ -191,3 +191,25 @@ struct DataPointer
 
 	DataPointer(void* ptr, int size) : Pointer(ptr), Size(size) {}
 };
+
+struct DataRange
+{
+	int Offset;
+	int Size;
+
+	DataRange(int offset, int size) : Offset(offset), Size(size) {}
+};
+
+// one named property of a geom sample, laid out as Count elements of Extent values of Type.
+// Type and Scope follow Alembic::Util::PlainOldDataType and Alembic::AbcGeom::GeometryScope
+struct AttributeStream
+{
+	void* Pointer;
+	int Size;
+	int Count;
+	int Type;
+	int Extent;
+	int Scope;
+
+	AttributeStream() : Pointer(nullptr), Size(0), Count(0), Type(127), Extent(0), Scope(127) {}
+};
@@ -15,9 +15,98 @@ void copyCharsWithStride(void* target, const string& source, size_t maxLength)
     *(static_cast<char*>(target) + 2 * span + 1) = '\0';
 }
 
-void computeMeshTangent(const V3f& p, const N3f& n, const V2f& uv, float* t)
+// unnormalized tangent and bitangent of a triangle, the per face part of VertexHelper.GenerateTangentBinormal in stride.
+// false when the uvs are degenerate
+bool computeMeshTangent(const V3f* p, const V2f* uv, V3f& tangent, V3f& bitangent)
 {
+    const V3f e1 = p[1] - p[0];
+    const V3f e2 = p[2] - p[0];
 
+    const V2f d1 = uv[1] - uv[0];
+    const V2f d2 = uv[2] - uv[0];
+
+    const float r = d1.x * d2.y - d2.x * d1.y;
+    if (abs(r) < 1e-12f)
+    {
+        tangent = bitangent = V3f(0);
+        return false;
+    }
+
+    tangent = (e1 * d2.y - e2 * d1.y) / r;
+    bitangent = (e2 * d1.x - e1 * d2.x) / r;
+    return true;
+}
+
+// weights of the 4 control points of a cubic span at u in [0, 1]
+void cubicBasisWeights(Alembic::AbcGeom::BasisType basis, float u, float* w)
+{
+    const float u2 = u * u;
+    const float u3 = u2 * u;
+    const float iu = 1 - u;
+
+    switch (basis)
+    {
+    case Alembic::AbcGeom::kBezierBasis:
+        w[0] = iu * iu * iu;
+        w[1] = 3 * u * iu * iu;
+        w[2] = 3 * u2 * iu;
+        w[3] = u3;
+        break;
+    case Alembic::AbcGeom::kBsplineBasis:
+        w[0] = iu * iu * iu / 6;
+        w[1] = (3 * u3 - 6 * u2 + 4) / 6;
+        w[2] = (-3 * u3 + 3 * u2 + 3 * u + 1) / 6;
+        w[3] = u3 / 6;
+        break;
+    case Alembic::AbcGeom::kCatmullromBasis:
+        w[0] = .5f * (-u3 + 2 * u2 - u);
+        w[1] = .5f * (3 * u3 - 5 * u2 + 2);
+        w[2] = .5f * (-3 * u3 + 4 * u2 + u);
+        w[3] = .5f * (u3 - u2);
+        break;
+    case Alembic::AbcGeom::kHermiteBasis: // p0, t0, p1, t1
+        w[0] = 2 * u3 - 3 * u2 + 1;
+        w[1] = u3 - 2 * u2 + u;
+        w[2] = -2 * u3 + 3 * u2;
+        w[3] = u3 - u2;
+        break;
+    default:
+        w[0] = iu;
+        w[1] = u;
+        w[2] = w[3] = 0;
+        break;
+    }
+}
+
+// de Boor's algorithm in homogeneous coordinates, order is limited to 16
+V3f evaluateNurbs(const V3f* points, const float* weights, const float* knots, int count, int order, float u)
+{
+    const int degree = order - 1;
+
+    int span = degree;
+    while (span < count - 1 && u >= knots[span + 1]) ++span;
+
+    Imath::V4f d[16];
+    for (int j = 0; j <= degree; ++j)
+    {
+        const V3f& p = points[span - degree + j];
+        const float w = weights != nullptr ? weights[span - degree + j] : 1.0f;
+        d[j] = Imath::V4f(p.x * w, p.y * w, p.z * w, w);
+    }
+
+    for (int r = 1; r <= degree; ++r)
+    {
+        for (int j = degree; j >= r; --j)
+        {
+            const int i = span - degree + j;
+            const float denom = knots[i + order - r] - knots[i];
+            const float a = denom != 0 ? (u - knots[i]) / denom : 0;
+            d[j] = d[j - 1] * (1 - a) + d[j] * a;
+        }
+    }
+
+    const Imath::V4f& p = d[degree];
+    return p.w != 0 ? V3f(p.x / p.w, p.y / p.w, p.z / p.w) : V3f(p.x, p.y, p.z);
 }
 
 void decomposeMatrix(const Imath::M44d& m, Imath::V3d& s, Imath::V3d& sh, Imath::Quatd& r, Imath::V3d& t)
@@ -1,14 +1,25 @@
 #pragma once
 
 #include <Alembic\Abc\All.h>
+#include <Alembic\AbcGeom\Basis.h>
 
 #include "abcrTypes.h"
 
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 
 void copyCharsWithStride(void* target, const string& source, size_t maxLength);
 
-void computeMeshTangent(const V3f& p, const N3f& n, const V2f& uv, float* t);
+bool computeMeshTangent(const V3f* p, const V2f* uv, V3f& tangent, V3f& bitangent);
+
+void cubicBasisWeights(Alembic::AbcGeom::BasisType basis, float u, float* w);
+
+V3f evaluateNurbs(const V3f* points, const float* weights, const float* knots, int count, int order, float u);
 
 void decomposeMatrix(const Imath::M44d& m, Imath::V3d& s, Imath::V3d& sh, Imath::Quatd& r, Imath::V3d& t);
 
@@ -34,6 +45,107 @@ inline N3f computeFaceNormal(const V3f& v0, const V3f& v1, const V3f& v2)
     return -((v1 - v0).cross(v2 - v0)).normalize();
 }
 
+// word wise FNV-1a, size is expected to be a multiple of 4
+inline uint64_t hashBytes(const void* data, size_t size)
+{
+    uint64_t h = 14695981039346656037ull;
+
+    const uint32_t* src = static_cast<const uint32_t*>(data);
+    for (size_t i = 0; i < size / 4; ++i)
+    {
+        h ^= src[i];
+        h *= 1099511628211ull;
+    }
+
+    return h;
+}
+
+// splitmix64 finalizer, well mixed bits from sequential keys like point ids
+inline uint64_t mixHash(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+// std::sort per thread chunk, then pairwise inplace_merge rounds
+template<typename T>
+void parallelSort(vector<T>& v)
+{
+    int chunks = 1;
+#ifdef _OPENMP
+    chunks = omp_get_max_threads();
+#endif
+
+    const size_t n = v.size();
+    if (chunks < 2 || n < (1 << 16))
+    {
+        std::sort(v.begin(), v.end());
+        return;
+    }
+
+    vector<size_t> bounds(chunks + 1);
+    for (int c = 0; c <= chunks; ++c) bounds[c] = n * c / chunks;
+
+    #pragma omp parallel for
+    for (int c = 0; c < chunks; ++c)
+        std::sort(v.begin() + bounds[c], v.begin() + bounds[c + 1]);
+
+    for (int width = 1; width < chunks; width *= 2)
+    {
+        #pragma omp parallel for
+        for (int c = 0; c < chunks; c += 2 * width)
+        {
+            if (c + width < chunks)
+                std::inplace_merge(v.begin() + bounds[c], v.begin() + bounds[c + width],
+                    v.begin() + bounds[std::min(c + 2 * width, chunks)]);
+        }
+    }
+}
+
+inline V3f perpendicular(const V3f& v)
+{
+    V3f axis = abs(v.x) < .9f ? V3f(1, 0, 0) : V3f(0, 1, 0);
+    return v.cross(axis).normalize();
+}
+
+// octahedral mapping of a unit vector onto [-1, 1]^2
+inline V2f octahedral(const V3f& n)
+{
+    const float l1 = abs(n.x) + abs(n.y) + abs(n.z);
+    float x = l1 > 0 ? n.x / l1 : 0;
+    float y = l1 > 0 ? n.y / l1 : 0;
+
+    if (n.z < 0)
+    {
+        const float ox = (1 - abs(y)) * (x >= 0 ? 1 : -1);
+        const float oy = (1 - abs(x)) * (y >= 0 ? 1 : -1);
+        x = ox;
+        y = oy;
+    }
+
+    return V2f(std::max(-1.0f, std::min(1.0f, x)), std::max(-1.0f, std::min(1.0f, y)));
+}
+
+inline void octEncode(const V3f& n, int16_t* o)
+{
+    const V2f oct = octahedral(n);
+
+    o[0] = (int16_t)roundf(oct.x * 32767);
+    o[1] = (int16_t)roundf(oct.y * 32767);
+}
+
+inline uint8_t toUnorm8(float v)
+{
+    return (uint8_t)(std::max(0.0f, std::min(1.0f, v)) * 255 + .5f);
+}
+
+inline uint16_t toUnorm16(float v)
+{
+    return (uint16_t)(std::max(0.0f, std::min(1.0f, v)) * 65535 + .5f);
+}
+
 inline Vector2 toVVVV(const Alembic::Abc::V2f& v)
 {
     return Vector2(v.x, 1 - v.y);
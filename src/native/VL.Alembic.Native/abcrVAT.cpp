@@ -0,0 +1,643 @@
+#include "abcrVAT.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace
+{
+    IObject findObject(IObject obj, const string& fullName)
+    {
+        size_t begin = 1;
+        while (obj && begin < fullName.size())
+        {
+            size_t end = fullName.find('/', begin);
+            if (end == string::npos) end = fullName.size();
+
+            obj = obj.getChild(fullName.substr(begin, end - begin));
+            begin = end + 1;
+        }
+
+        return obj;
+    }
+
+    Imath::M44d sampleMatrix(AbcGeom::IXformSchema& xform, chrono_t time, bool interpolate)
+    {
+        if (!interpolate || xform.isConstant())
+            return xform.getValue(ISampleSelector(time, ISampleSelector::kNearIndex)).getMatrix();
+
+        ISampleSelector ss0(time, ISampleSelector::kFloorIndex);
+        ISampleSelector ss1(time, ISampleSelector::kCeilIndex);
+
+        auto sampling = xform.getTimeSampling();
+        auto numSamples = xform.getNumSamples();
+        auto index0 = ss0.getIndex(sampling, numSamples);
+        auto index1 = ss1.getIndex(sampling, numSamples);
+
+        const Imath::M44d m0 = xform.getValue(ss0).getMatrix();
+        if (index0 == index1) return m0;
+
+        const Imath::M44d m1 = xform.getValue(ss1).getMatrix();
+
+        auto time0 = sampling->getSampleTime(index0);
+        auto time1 = sampling->getSampleTime(index1);
+        const double t = (time - time0) / (time1 - time0);
+
+        Imath::V3d t0, t1;
+        Imath::V3d s0, s1;
+        Imath::V3d sh0, sh1;
+        Imath::Quatd r0, r1;
+
+        decomposeMatrix(m0, s0, sh0, r0, t0);
+        decomposeMatrix(m1, s1, sh1, r1, t1);
+
+        Imath::M44d m;
+        m.makeIdentity();
+        m.scale(s0 * (1 - t) + s1 * t);
+        m *= Imath::slerpShortestArc(r0, r1, t).toMatrix44();
+
+        Imath::V3d t2 = t0 * (1 - t) + t1 * t;
+        m[3][0] = t2.x;
+        m[3][1] = t2.y;
+        m[3][2] = t2.z;
+
+        return m;
+    }
+
+    int largerPowerOfTwo(double x)
+    {
+        int size = 1;
+        while (size < x) size <<= 1;
+        return size;
+    }
+}
+
+VATBaker::VATBaker(const string& path, const string& fullName)
+    : _path(path), _fullName(fullName) {}
+
+bool VATBaker::bake(chrono_t startTime, chrono_t endTime, int fps, int textureWidth, bool interpolate,
+    VATEncoding::Type encoding, bool rigid, float tolerance)
+{
+    if (fps <= 0 || endTime <= startTime) return false;
+
+    // translations and quaternions have no fixed range to normalize to
+    if (rigid && encoding == VATEncoding::COMPACT16) return false;
+
+    int numThreads = 1;
+#ifdef _OPENMP
+    numThreads = std::max(1, omp_get_max_threads());
+#endif
+
+    // one ogawa stream per worker so frames can be read concurrently
+    IArchive archive(AbcCoreOgawa::ReadArchive(numThreads, true), _path,
+        Alembic::Abc::ErrorHandler::kQuietNoopPolicy);
+
+    if (!archive.valid()) return false;
+
+    IObject obj = findObject(archive.getTop(), _fullName);
+    if (!obj || !AbcGeom::IPolyMesh::matches(obj.getHeader())) return false;
+
+    {
+        PolyMesh mesh((AbcGeom::IPolyMesh(obj, kWrapExisting)));
+        _info.VertexCount = std::max(mesh.getMaxVertexCount(), 0);
+    }
+
+    if (_info.VertexCount == 0) return false;
+
+    _info.Fps = fps;
+    _info.Encoding = encoding;
+    _info.FrameCount = std::max(1, (int)floor((endTime - startTime) * fps + .5));
+    _info.EndTime = (float)_info.FrameCount / fps;
+    _info.KeyFrameCount = _info.FrameCount;
+
+    if (!this->evaluateFrames(obj, startTime, interpolate, numThreads)) return false;
+
+    if (rigid && !this->extractPieces(obj, startTime, interpolate)) return false;
+
+    const int texelsPerFrame = rigid ? _info.PieceCount : _info.VertexCount;
+
+    if (tolerance > 0) this->reduceFrames(texelsPerFrame, tolerance);
+
+    this->layoutTextures(texelsPerFrame, textureWidth);
+
+    if (encoding == VATEncoding::COMPACT16) this->computeBounds();
+
+    this->writeTextures();
+
+    vector<Imath::V4f>().swap(_framePositions);
+    vector<Imath::V4f>().swap(_frameNormals);
+
+    if (encoding != VATEncoding::FLOAT32) this->encode();
+
+    return true;
+}
+
+bool VATBaker::evaluateFrames(IObject obj, chrono_t startTime, bool interpolate, int numThreads)
+{
+    const int frameCount = _info.FrameCount;
+    const int vertexCount = _info.VertexCount;
+
+    _framePositions.assign((size_t)frameCount * vertexCount, Imath::V4f(0));
+    _frameNormals.assign((size_t)frameCount * vertexCount, Imath::V4f(0));
+    _frameVertexCounts.assign(frameCount, 0);
+
+    int failed = 0;
+
+    #pragma omp parallel num_threads(numThreads)
+    {
+        // every worker evaluates through its own PolyMesh and xform schemas
+        unique_ptr<PolyMesh> mesh;
+        vector<AbcGeom::IXformSchema> parents;
+
+        try
+        {
+            mesh.reset(new PolyMesh(AbcGeom::IPolyMesh(obj, kWrapExisting)));
+            mesh->setInterpolate(interpolate);
+
+            for (IObject p = obj.getParent(); p; p = p.getParent())
+            {
+                if (AbcGeom::IXform::matches(p.getHeader()))
+                    parents.push_back(AbcGeom::IXform(p, kWrapExisting).getSchema());
+            }
+        }
+        catch (...)
+        {
+            mesh.reset();
+            #pragma omp atomic write
+            failed = 1;
+        }
+
+        #pragma omp for schedule(dynamic)
+        for (int f = 0; f < frameCount; ++f)
+        {
+            if (!mesh) continue;
+
+            try
+            {
+                const chrono_t time = startTime + (chrono_t)f / _info.Fps;
+
+                Imath::M44f m;
+                m.makeIdentity();
+                mesh->set(time, m);
+
+                int size = 0;
+                const float* stream = mesh->get(&size);
+                if (stream == nullptr || size == 0) continue;
+
+                Imath::M44d world;
+                world.makeIdentity();
+                for (size_t i = 0; i < parents.size(); ++i)
+                    world = world * sampleMatrix(parents[i], time, interpolate);
+
+                const Imath::M44f w(world);
+                const Imath::M44f normalMatrix = w.inverse().transpose();
+
+                const size_t stride = mesh->getVertexSize() / 4;
+                const int count = std::min(mesh->getVertexCount(), vertexCount) / 3 * 3;
+
+                Imath::V4f* pos = &_framePositions[(size_t)f * vertexCount];
+                Imath::V4f* norm = &_frameNormals[(size_t)f * vertexCount];
+
+                for (int i = 0; i < count; ++i)
+                {
+                    // flip the winding as the compute baker does
+                    const int vid = i + 2 - (i % 3) * 2;
+                    const float* v = stream + vid * stride;
+
+                    V3f p, n;
+                    w.multVecMatrix(V3f(v[0], v[1], v[2]), p);
+                    normalMatrix.multDirMatrix(V3f(v[3], v[4], v[5]), n);
+                    n.normalize();
+
+                    const float* uv = v + stride - 2;
+                    pos[i] = Imath::V4f(p.x, p.y, p.z, uv[0]);
+                    norm[i] = Imath::V4f(n.x, n.y, n.z, uv[1]);
+                }
+
+                _frameVertexCounts[f] = count;
+            }
+            catch (...)
+            {
+                #pragma omp atomic write
+                failed = 1;
+            }
+        }
+    }
+
+    return failed == 0;
+}
+
+bool VATBaker::extractPieces(IObject obj, chrono_t startTime, bool interpolate)
+{
+    AbcGeom::IPolyMeshSchema schema = AbcGeom::IPolyMesh(obj, kWrapExisting).getSchema();
+    if (schema.getTopologyVariance() == AbcGeom::kHeterogenousTopology) return false;
+
+    AbcGeom::IPolyMeshSchema::Sample sample;
+    schema.get(sample, ISampleSelector(startTime, ISampleSelector::kNearIndex));
+
+    const int32_t* indices = sample.getFaceIndices()->get();
+    const int32_t* faceCounts = sample.getFaceCounts()->get();
+    const size_t nInds = sample.getFaceIndices()->size();
+    const size_t nFace = sample.getFaceCounts()->size();
+    const size_t nPts = sample.getPositions()->size();
+
+    vector<int> parent(nPts);
+    for (size_t i = 0; i < nPts; ++i) parent[i] = (int)i;
+
+    auto find = [&parent](int x)
+    {
+        while (parent[x] != x)
+        {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    };
+
+    size_t begin = 0;
+    for (size_t face = 0; face < nFace; ++face)
+    {
+        const size_t count = faceCounts[face];
+        if (begin + count > nInds) return false;
+
+        for (size_t c = 1; c < count; ++c)
+            parent[find(indices[begin + c])] = find(indices[begin]);
+
+        begin += count;
+    }
+
+    // points of the stream vertices of the first frame as PolyMesh wrote them, face sets reorder the triangles
+    vector<int> streamPoints;
+    {
+        PolyMesh mesh((AbcGeom::IPolyMesh(obj, kWrapExisting)));
+        mesh.setInterpolate(interpolate);
+
+        Imath::M44f m;
+        m.makeIdentity();
+        mesh.set(startTime, m);
+
+        if (!mesh.getStreamPoints(streamPoints)) return false;
+    }
+
+    for (int p : streamPoints)
+        if (p < 0 || p >= (int)nPts) return false;
+
+    const int vertexCount = std::min((int)streamPoints.size(), _info.VertexCount);
+    const int frameCount = _info.FrameCount;
+
+    vector<int> pieceOfRoot(nPts, -1);
+    vector<int> pieceOfVertex(vertexCount);
+    int pieceCount = 0;
+
+    for (int i = 0; i < vertexCount; ++i)
+    {
+        const int root = find(streamPoints[i + 2 - (i % 3) * 2]);
+        if (pieceOfRoot[root] < 0) pieceOfRoot[root] = pieceCount++;
+        pieceOfVertex[i] = pieceOfRoot[root];
+    }
+
+    if (pieceCount == 0) return false;
+
+    vector<int> offsets(pieceCount + 1, 0);
+    for (int i = 0; i < vertexCount; ++i) offsets[pieceOfVertex[i] + 1]++;
+    for (int p = 0; p < pieceCount; ++p) offsets[p + 1] += offsets[p];
+
+    vector<int> members(vertexCount);
+    {
+        vector<int> cursor(offsets.begin(), offsets.end() - 1);
+        for (int i = 0; i < vertexCount; ++i) members[cursor[pieceOfVertex[i]]++] = i;
+    }
+
+    _restPositions.resize(_info.VertexCount, Imath::V4f(0));
+    _restNormals.resize(_info.VertexCount, Imath::V4f(0));
+
+    for (int i = 0; i < vertexCount; ++i)
+    {
+        const Imath::V4f& p = _framePositions[i];
+        const Imath::V4f& n = _frameNormals[i];
+        _restPositions[i] = Imath::V4f(p.x, p.y, p.z, (float)pieceOfVertex[i]);
+        _restNormals[i] = Imath::V4f(n.x, n.y, n.z, 0);
+    }
+
+    vector<Imath::V4f> translations((size_t)frameCount * pieceCount);
+    vector<Imath::V4f> rotations((size_t)frameCount * pieceCount);
+
+    const int stride = _info.VertexCount;
+    const vector<Imath::V4f>& frames = _framePositions;
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int p = 0; p < pieceCount; ++p)
+    {
+        const int* m = &members[offsets[p]];
+        const int n = offsets[p + 1] - offsets[p];
+
+        auto position = [&frames, stride](int f, int i)
+        {
+            const Imath::V4f& v = frames[(size_t)f * stride + i];
+            return V3f(v.x, v.y, v.z);
+        };
+
+        auto centroid = [&](int f)
+        {
+            V3f c(0);
+            for (int k = 0; k < n; ++k) c += position(f, m[k]);
+            return c / (float)n;
+        };
+
+        // two vertices spanning the piece in the rest pose define its frame
+        const V3f c0 = centroid(0);
+
+        int a = -1, b = -1;
+        float best = 0;
+        for (int k = 0; k < n; ++k)
+        {
+            const float d = (position(0, m[k]) - c0).length2();
+            if (d > best) { best = d; a = m[k]; }
+        }
+
+        if (a >= 0)
+        {
+            const V3f e1 = (position(0, a) - c0).normalized();
+            const float limit = best * 1e-8f;
+
+            best = limit;
+            for (int k = 0; k < n; ++k)
+            {
+                V3f v = position(0, m[k]) - c0;
+                v -= e1 * v.dot(e1);
+                if (v.length2() > best) { best = v.length2(); b = m[k]; }
+            }
+        }
+
+        auto basis = [&](int f, const V3f& c)
+        {
+            const V3f e1 = (position(f, a) - c).normalized();
+            V3f e2 = position(f, b) - c;
+            e2 = (e2 - e1 * e2.dot(e1)).normalized();
+            const V3f e3 = e1 % e2;
+
+            return Imath::M33f(e1.x, e1.y, e1.z, e2.x, e2.y, e2.z, e3.x, e3.y, e3.z);
+        };
+
+        const Imath::M33f restBasis = b >= 0 ? basis(0, c0).transposed() : Imath::M33f();
+
+        Imath::Quatf prev;
+        for (int f = 0; f < frameCount; ++f)
+        {
+            const V3f c = centroid(f);
+
+            Imath::M33f r;
+            if (b >= 0) r = restBasis * basis(f, c);
+
+            Imath::Quatf q = Imath::extractQuat(Imath::M44f(r, V3f(0))).normalized();
+
+            // keep the shortest path between frames for the sampler lerp
+            if (f > 0 && (q ^ prev) < 0) q = -q;
+            prev = q;
+
+            const V3f t = c - c0 * r;
+
+            translations[(size_t)f * pieceCount + p] = Imath::V4f(t.x, t.y, t.z, 0);
+            rotations[(size_t)f * pieceCount + p] = Imath::V4f(q.v.x, q.v.y, q.v.z, q.r);
+        }
+    }
+
+    _framePositions.swap(translations);
+    _frameNormals.swap(rotations);
+    _info.PieceCount = pieceCount;
+
+    return true;
+}
+
+bool VATBaker::isLinear(int texelsPerFrame, int first, int last, float tolerance) const
+{
+    // normals, uvs and rotations are compared in their own units
+    const float directionTolerance = 1e-2f;
+
+    const Imath::V4f* p0 = &_framePositions[(size_t)first * texelsPerFrame];
+    const Imath::V4f* p1 = &_framePositions[(size_t)last * texelsPerFrame];
+    const Imath::V4f* n0 = &_frameNormals[(size_t)first * texelsPerFrame];
+    const Imath::V4f* n1 = &_frameNormals[(size_t)last * texelsPerFrame];
+
+    for (int f = first + 1; f < last; ++f)
+    {
+        const float t = (float)(f - first) / (last - first);
+        const Imath::V4f* p = &_framePositions[(size_t)f * texelsPerFrame];
+        const Imath::V4f* n = &_frameNormals[(size_t)f * texelsPerFrame];
+
+        int failed = 0;
+
+        #pragma omp parallel for reduction(|:failed)
+        for (int i = 0; i < texelsPerFrame; ++i)
+        {
+            const Imath::V4f dp = p0[i] + (p1[i] - p0[i]) * t - p[i];
+            const Imath::V4f dn = n0[i] + (n1[i] - n0[i]) * t - n[i];
+
+            if (V3f(dp.x, dp.y, dp.z).length2() > tolerance * tolerance ||
+                abs(dp.w) > directionTolerance || dn.length2() > directionTolerance * directionTolerance)
+                failed |= 1;
+        }
+
+        if (failed) return false;
+    }
+
+    return true;
+}
+
+void VATBaker::reduceFrames(int texelsPerFrame, float tolerance)
+{
+    const int frameCount = _info.FrameCount;
+
+    vector<int> keys(1, 0);
+    int first = 0;
+
+    while (first < frameCount - 1)
+    {
+        // grow the span exponentially, then bisect between the last good and first bad end
+        int good = first + 1;
+        int bad = frameCount;
+
+        for (int step = 2; first + step < frameCount; step *= 2)
+        {
+            if (!this->isLinear(texelsPerFrame, first, first + step, tolerance))
+            {
+                bad = first + step;
+                break;
+            }
+            good = first + step;
+        }
+
+        if (bad == frameCount && good < frameCount - 1)
+        {
+            if (this->isLinear(texelsPerFrame, first, frameCount - 1, tolerance)) good = frameCount - 1;
+            else bad = frameCount - 1;
+        }
+
+        while (bad - good > 1)
+        {
+            const int mid = (good + bad) / 2;
+            if (this->isLinear(texelsPerFrame, first, mid, tolerance)) good = mid;
+            else bad = mid;
+        }
+
+        keys.push_back(good);
+        first = good;
+    }
+
+    const int keyCount = (int)keys.size();
+
+    _frameRemap.resize(frameCount);
+    for (int k = 0; k + 1 < keyCount; ++k)
+    {
+        for (int f = keys[k]; f < keys[k + 1]; ++f)
+            _frameRemap[f] = k + (float)(f - keys[k]) / (keys[k + 1] - keys[k]);
+    }
+    _frameRemap[frameCount - 1] = (float)(keyCount - 1);
+
+    // keys are ascending, so moving them to the front never overwrites a later key
+    for (int k = 1; k < keyCount; ++k)
+    {
+        const size_t src = (size_t)keys[k] * texelsPerFrame;
+        const size_t dst = (size_t)k * texelsPerFrame;
+
+        std::copy(&_framePositions[src], &_framePositions[src] + texelsPerFrame, &_framePositions[dst]);
+        std::copy(&_frameNormals[src], &_frameNormals[src] + texelsPerFrame, &_frameNormals[dst]);
+        _frameVertexCounts[k] = _frameVertexCounts[keys[k]];
+    }
+
+    _framePositions.resize((size_t)keyCount * texelsPerFrame);
+    _frameNormals.resize((size_t)keyCount * texelsPerFrame);
+    _frameVertexCounts.resize(keyCount);
+
+    _info.KeyFrameCount = keyCount;
+}
+
+void VATBaker::layoutTextures(int texelsPerFrame, int textureWidth)
+{
+    const double pixelCount = (double)texelsPerFrame * _info.KeyFrameCount;
+    _info.TextureWidth = textureWidth > 0 ? textureWidth : largerPowerOfTwo(ceil(sqrt(pixelCount)));
+    _info.NumLines = (texelsPerFrame + _info.TextureWidth - 1) / _info.TextureWidth;
+    _info.TextureHeight = _info.NumLines * _info.KeyFrameCount;
+}
+
+void VATBaker::computeBounds()
+{
+    const int frameCount = _info.KeyFrameCount;
+    const int vertexCount = _info.VertexCount;
+
+    Imath::Box3f bounds;
+    Imath::Box2f uvBounds;
+
+    #pragma omp parallel
+    {
+        Imath::Box3f localBounds;
+        Imath::Box2f localUvBounds;
+
+        #pragma omp for
+        for (int f = 0; f < frameCount; ++f)
+        {
+            const Imath::V4f* pos = &_framePositions[(size_t)f * vertexCount];
+            const Imath::V4f* norm = &_frameNormals[(size_t)f * vertexCount];
+
+            for (int i = 0; i < _frameVertexCounts[f]; ++i)
+            {
+                localBounds.extendBy(V3f(pos[i].x, pos[i].y, pos[i].z));
+                localUvBounds.extendBy(V2f(pos[i].w, norm[i].w));
+            }
+        }
+
+        #pragma omp critical
+        {
+            bounds.extendBy(localBounds);
+            uvBounds.extendBy(localUvBounds);
+        }
+    }
+
+    if (bounds.isEmpty()) bounds.extendBy(V3f(0));
+    if (uvBounds.isEmpty()) uvBounds.extendBy(V2f(0));
+
+    _info.BoundsMin = toVVVV(bounds.min);
+    _info.BoundsMax = toVVVV(bounds.max);
+    _info.UvMin = Vector2(uvBounds.min.x, uvBounds.min.y);
+    _info.UvMax = Vector2(uvBounds.max.x, uvBounds.max.y);
+}
+
+void VATBaker::writeTextures()
+{
+    const int width = _info.TextureWidth;
+    const int height = _info.TextureHeight;
+    const int frameCount = _info.KeyFrameCount;
+    const int vertexCount = _info.PieceCount > 0 ? _info.PieceCount : _info.VertexCount;
+
+    _positions.assign((size_t)width * height, Imath::V4f(0));
+    _normals.assign((size_t)width * height, Imath::V4f(0));
+
+    #pragma omp parallel for
+    for (int row = 0; row < height; ++row)
+    {
+        const int line = row / frameCount;
+        const int frame = row % frameCount;
+
+        const int first = line * width;
+        const int count = std::min(width, vertexCount - first);
+
+        const size_t src = (size_t)frame * vertexCount + first;
+        const size_t dst = (size_t)row * width;
+
+        std::copy(&_framePositions[src], &_framePositions[src] + count, &_positions[dst]);
+        std::copy(&_frameNormals[src], &_frameNormals[src] + count, &_normals[dst]);
+    }
+}
+
+void VATBaker::encode()
+{
+    const size_t texelCount = _positions.size();
+
+    _packedPositions.resize(texelCount * 4);
+    _packedNormals.resize(texelCount * 4);
+
+    const bool compact = _info.Encoding == VATEncoding::COMPACT16;
+
+    const V3f boundsMin(_info.BoundsMin.x, _info.BoundsMin.y, _info.BoundsMin.z);
+    const V3f boundsSize = V3f(_info.BoundsMax.x, _info.BoundsMax.y, _info.BoundsMax.z) - boundsMin;
+    const V2f uvMin(_info.UvMin.x, _info.UvMin.y);
+    const V2f uvSize = V2f(_info.UvMax.x, _info.UvMax.y) - uvMin;
+
+    auto normalize = [](float v, float min, float size) { return size > 0 ? (v - min) / size : 0; };
+
+    #pragma omp parallel for
+    for (int64_t i = 0; i < (int64_t)texelCount; ++i)
+    {
+        const Imath::V4f& p = _positions[i];
+        const Imath::V4f& n = _normals[i];
+
+        uint16_t* op = &_packedPositions[i * 4];
+        uint16_t* on = &_packedNormals[i * 4];
+
+        if (compact)
+        {
+            const V2f oct = octahedral(V3f(n.x, n.y, n.z));
+
+            op[0] = toUnorm16(normalize(p.x, boundsMin.x, boundsSize.x));
+            op[1] = toUnorm16(normalize(p.y, boundsMin.y, boundsSize.y));
+            op[2] = toUnorm16(normalize(p.z, boundsMin.z, boundsSize.z));
+            op[3] = toUnorm16(normalize(p.w, uvMin.x, uvSize.x));
+
+            on[0] = toUnorm16(oct.x * .5f + .5f);
+            on[1] = toUnorm16(oct.y * .5f + .5f);
+            on[2] = toUnorm16(normalize(n.w, uvMin.y, uvSize.y));
+            on[3] = 0;
+        }
+        else
+        {
+            for (int c = 0; c < 4; ++c)
+            {
+                op[c] = half(p[c]).bits();
+                on[c] = half(n[c]).bits();
+            }
+        }
+    }
+
+    vector<Imath::V4f>().swap(_positions);
+    vector<Imath::V4f>().swap(_normals);
+}
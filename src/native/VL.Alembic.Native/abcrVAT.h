@@ -0,0 +1,135 @@
+#pragma once
+
+#include <Alembic\Abc\All.h>
+#include <Alembic\AbcCoreOgawa\All.h>
+
+#include "abcrGeom.h"
+
+using namespace std;
+using namespace Alembic;
+using namespace Alembic::Abc;
+
+namespace VATEncoding
+{
+    enum Type
+    {
+        FLOAT32 = 0,
+        COMPACT16,  // position / uv normalized to the baked bounds, octahedral normal, all unorm16
+        FLOAT16
+    };
+}
+
+// metadata VATPlayer needs to read the textures back
+struct VATInfo
+{
+    int Fps;
+    int FrameCount;
+    float EndTime;
+
+    int TextureWidth;
+    int TextureHeight;
+
+    int NumLines;
+    int VertexCount;
+
+    VATEncoding::Type Encoding;
+
+    // decode range of COMPACT16
+    Vector3 BoundsMin;
+    Vector3 BoundsMax;
+    Vector2 UvMin;
+    Vector2 UvMax;
+
+    // rigid bakes store one texel per piece instead of per vertex, 0 otherwise
+    int PieceCount;
+
+    // frames stored per line, less than FrameCount when the bake is reduced
+    int KeyFrameCount;
+
+    VATInfo()
+    {
+        Fps = FrameCount = TextureWidth = TextureHeight = NumLines = VertexCount = PieceCount = KeyFrameCount = 0;
+        EndTime = 0;
+        Encoding = VATEncoding::FLOAT32;
+    }
+};
+
+// bakes one PolyMesh into position / normal textures on the cpu.
+// texel (vid % width, vid / width * FrameCount + frame) holds float4(pos, u) and float4(norm, v),
+// same as VertexAnimationBaker_Internal_ComputeFX. COMPACT16 stores unorm4(pos, u) and unorm4(oct(norm), v, 0).
+// rigid bakes store float4(translation, 0) and the rotation quaternion per piece, with the rest pose
+// and piece id of every vertex in a static stream
+class VATBaker
+{
+public:
+
+    VATBaker(const string& path, const string& fullName);
+
+    bool bake(chrono_t startTime, chrono_t endTime, int fps, int textureWidth, bool interpolate,
+        VATEncoding::Type encoding = VATEncoding::FLOAT32, bool rigid = false, float tolerance = 0);
+
+    const VATInfo& getInfo() const { return _info; }
+
+    void get(DataPointer* opos, DataPointer* onorm)
+    {
+        if (_info.Encoding == VATEncoding::FLOAT32)
+        {
+            *opos = DataPointer(_positions.data(), (int)(_positions.size() * sizeof(Imath::V4f)));
+            *onorm = DataPointer(_normals.data(), (int)(_normals.size() * sizeof(Imath::V4f)));
+        }
+        else
+        {
+            *opos = DataPointer(_packedPositions.data(), (int)(_packedPositions.size() * sizeof(uint16_t)));
+            *onorm = DataPointer(_packedNormals.data(), (int)(_packedNormals.size() * sizeof(uint16_t)));
+        }
+    }
+
+    // fractional key frame of every baked frame, empty when the bake is not reduced
+    const float* getFrameRemap(int* count) const
+    {
+        *count = (int)_frameRemap.size();
+        return _frameRemap.data();
+    }
+
+    // float4(position, piece id) and float4(normal, 0) of every vertex at the first frame
+    void getRest(DataPointer* opos, DataPointer* onorm)
+    {
+        *opos = DataPointer(_restPositions.data(), (int)(_restPositions.size() * sizeof(Imath::V4f)));
+        *onorm = DataPointer(_restNormals.data(), (int)(_restNormals.size() * sizeof(Imath::V4f)));
+    }
+
+private:
+
+    string _path;
+    string _fullName;
+
+    VATInfo _info;
+
+    // frame major, FrameCount * VertexCount
+    vector<Imath::V4f> _framePositions;
+    vector<Imath::V4f> _frameNormals;
+
+    // valid vertices of each frame, the rest is padding
+    vector<int> _frameVertexCounts;
+
+    vector<Imath::V4f> _positions;
+    vector<Imath::V4f> _normals;
+
+    // four 16 bit channels per texel, FLOAT16 or COMPACT16
+    vector<uint16_t> _packedPositions;
+    vector<uint16_t> _packedNormals;
+
+    vector<Imath::V4f> _restPositions;
+    vector<Imath::V4f> _restNormals;
+
+    vector<float> _frameRemap;
+
+    bool evaluateFrames(IObject obj, chrono_t startTime, bool interpolate, int numThreads);
+    bool extractPieces(IObject obj, chrono_t startTime, bool interpolate);
+    bool isLinear(int texelsPerFrame, int first, int last, float tolerance) const;
+    void reduceFrames(int texelsPerFrame, float tolerance);
+    void layoutTextures(int texelsPerFrame, int textureWidth);
+    void computeBounds();
+    void writeTextures();
+    void encode();
+};